@@ -0,0 +1,152 @@
+#ifndef STACK_QUEUE_HAZARDPOINTER_H
+#define STACK_QUEUE_HAZARDPOINTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Hazard pointers for lock-free structures that unlink nodes other threads
+// may still be reading. Before dereferencing a shared node a thread
+// publishes its address in its hazard slot; a node that has been unlinked
+// is retired instead of deleted and freed only by a later scan that finds
+// it in no slot. Every thread owns one slot, so a thread may protect one
+// node at a time, and at most kMaxThreads threads may hold slots at once.
+class HazardPointers {
+public:
+    static const size_t kMaxThreads = 128;
+
+    using Deleter = void (*)(void*);
+
+    // publishes ptr in the calling thread's slot; the caller must check
+    // afterwards that ptr is still reachable before trusting it
+    static void Protect(void* ptr) {
+        LocalSlot().pointer_.store(ptr);
+    }
+
+    static void Clear() {
+        LocalSlot().pointer_.store(nullptr, std::memory_order_release);
+    }
+
+    // deleter(ptr) runs once no slot holds ptr any more
+    static void Retire(void* ptr, Deleter deleter) {
+        RetiredList& retired = LocalRetired();
+        retired.nodes_.emplace_back(ptr, deleter);
+        if (retired.nodes_.size() >= kScanThreshold) {
+            Instance().Scan(retired.nodes_);
+        }
+    }
+
+private:
+    // amortizes a scan over enough retired nodes that most can be freed
+    static const size_t kScanThreshold = 2 * kMaxThreads;
+
+    using Retired = std::pair<void*, Deleter>;
+
+    struct alignas(64) Slot {
+        std::atomic<bool> in_use_{false};
+        std::atomic<void*> pointer_{nullptr};
+    };
+
+    // gives the slot back when its thread exits
+    struct SlotOwner {
+        Slot* slot_;
+
+        SlotOwner() : slot_(Instance().Acquire()) {
+        }
+
+        ~SlotOwner() {
+            slot_->pointer_.store(nullptr);
+            slot_->in_use_.store(false, std::memory_order_release);
+        }
+    };
+
+    // what is still protected when its thread exits is left to other threads
+    struct RetiredList {
+        std::vector<Retired> nodes_;
+
+        ~RetiredList() {
+            Instance().Scan(nodes_);
+            if (!nodes_.empty()) {
+                std::lock_guard<std::mutex> lock(Instance().orphans_mutex_);
+                Instance().orphans_.insert(Instance().orphans_.end(), nodes_.begin(), nodes_.end());
+                Instance().has_orphans_.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    Slot slots_[kMaxThreads];
+    std::mutex orphans_mutex_;
+    std::vector<Retired> orphans_;
+    // lets Scan skip the mutex while no thread has left nodes behind
+    std::atomic<bool> has_orphans_{false};
+
+    HazardPointers() = default;
+
+    // by now no thread is left to read the orphans
+    ~HazardPointers() {
+        for (const Retired& node : orphans_) {
+            node.second(node.first);
+        }
+    }
+
+    static HazardPointers& Instance() {
+        static HazardPointers instance;
+        return instance;
+    }
+
+    static Slot& LocalSlot() {
+        thread_local SlotOwner owner;
+        return *owner.slot_;
+    }
+
+    static RetiredList& LocalRetired() {
+        thread_local RetiredList retired;
+        return retired;
+    }
+
+    Slot* Acquire() {
+        for (Slot& slot : slots_) {
+            bool expected = false;
+            if (!slot.in_use_.load(std::memory_order_relaxed)
+                && slot.in_use_.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return &slot;
+            }
+        }
+        throw std::runtime_error("HazardPointers: more than kMaxThreads threads");
+    }
+
+    // frees every node of retired that no slot protects, keeps the rest
+    void Scan(std::vector<Retired>& retired) {
+        if (has_orphans_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(orphans_mutex_);
+            retired.insert(retired.end(), orphans_.begin(), orphans_.end());
+            orphans_.clear();
+            has_orphans_.store(false, std::memory_order_relaxed);
+        }
+
+        std::vector<void*> protected_pointers;
+        protected_pointers.reserve(kMaxThreads);
+        for (const Slot& slot : slots_) {
+            if (void* ptr = slot.pointer_.load()) {
+                protected_pointers.push_back(ptr);
+            }
+        }
+        std::sort(protected_pointers.begin(), protected_pointers.end());
+
+        size_t kept = 0;
+        for (const Retired& node : retired) {
+            if (std::binary_search(protected_pointers.begin(), protected_pointers.end(), node.first)) {
+                retired[kept++] = node;
+            } else {
+                node.second(node.first);
+            }
+        }
+        retired.resize(kept);
+    }
+};
+
+#endif //STACK_QUEUE_HAZARDPOINTER_H
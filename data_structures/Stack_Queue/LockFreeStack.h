@@ -0,0 +1,150 @@
+#ifndef STACK_QUEUE_LOCKFREESTACK_H
+#define STACK_QUEUE_LOCKFREESTACK_H
+
+#include "HazardPointer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+// Treiber stack: the node-based Stack with its head swapped by CAS, so any
+// number of threads may push and pop without a lock.
+//
+// The head carries a 16-bit tag in the unused upper bits of the pointer
+// (user-space addresses fit in 48 bits) and every successful CAS bumps it,
+// so a head that was popped and pushed back in between no longer compares
+// equal (the ABA problem). Popped nodes are retired through HazardPointers:
+// a thread that read the head and is about to read head->next_ keeps that
+// node alive until it is done.
+template <class T>
+class LockFreeStack {
+    static_assert(sizeof(void*) == 8, "the tag lives in the upper bits of a 64-bit pointer");
+
+public:
+    LockFreeStack() : head_(0), size_(0) {
+    }
+
+    LockFreeStack(const LockFreeStack& other) = delete;
+
+    LockFreeStack& operator=(const LockFreeStack& other) = delete;
+
+    // no other thread may use the stack any more
+    ~LockFreeStack() {
+        Node* node = Pointer(head_.load(std::memory_order_acquire));
+        while (node != nullptr) {
+            Node* next = node->next_;
+            delete node;
+            node = next;
+        }
+    }
+
+    void Push(const T& value) {
+        Emplace(value);
+    }
+
+    void Push(T&& value) {
+        Emplace(std::move(value));
+    }
+
+    template <class... Args>
+    void Emplace(Args&&... args) {
+        Node* node = new Node{T(std::forward<Args>(args)...), nullptr};
+        // counted before it is visible, so a racing pop cannot take Size below zero
+        size_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            node->next_ = Pointer(head);
+        } while (!head_.compare_exchange_weak(head, Pack(node, Tag(head) + 1),
+                                              std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    bool TryPop(T& value) {
+        Node* node = Unlink();
+        if (node == nullptr) {
+            return false;
+        }
+        value = std::move(node->value_);
+        HazardPointers::Retire(node, &DeleteNode);
+        return true;
+    }
+
+    std::optional<T> Pop() {
+        Node* node = Unlink();
+        if (node == nullptr) {
+            return std::nullopt;
+        }
+        std::optional<T> result(std::move(node->value_));
+        HazardPointers::Retire(node, &DeleteNode);
+        return result;
+    }
+
+    // a snapshot that may already be stale when it returns
+    size_t Size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    bool Empty() const {
+        return Pointer(head_.load(std::memory_order_acquire)) == nullptr;
+    }
+
+private:
+    struct Node {
+        T value_;
+        Node* next_;
+    };
+
+    static const int kTagShift = 48;
+    static const uint64_t kPointerMask = (uint64_t(1) << kTagShift) - 1;
+
+    std::atomic<uint64_t> head_;
+    std::atomic<size_t> size_;
+
+    static Node* Pointer(uint64_t tagged) {
+        return reinterpret_cast<Node*>(tagged & kPointerMask);
+    }
+
+    static uint64_t Tag(uint64_t tagged) {
+        return tagged >> kTagShift;
+    }
+
+    static uint64_t Pack(Node* node, uint64_t tag) {
+        return (tag << kTagShift) | reinterpret_cast<uint64_t>(node);
+    }
+
+    static void DeleteNode(void* node) {
+        delete static_cast<Node*>(node);
+    }
+
+    // takes the top node off the stack; the caller owns it and must retire it
+    Node* Unlink() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        Node* node;
+        for (;;) {
+            node = Pointer(head);
+            if (node == nullptr) {
+                HazardPointers::Clear();
+                return nullptr;
+            }
+
+            HazardPointers::Protect(node);
+            // node may have been popped and freed before it was protected
+            const uint64_t current = head_.load();
+            if (current != head) {
+                head = current;
+                continue;
+            }
+
+            if (head_.compare_exchange_weak(head, Pack(node->next_, Tag(head) + 1),
+                                            std::memory_order_acquire, std::memory_order_acquire)) {
+                break;
+            }
+        }
+        HazardPointers::Clear();
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return node;
+    }
+};
+
+#endif //STACK_QUEUE_LOCKFREESTACK_H
@@ -1,21 +1,179 @@
 #ifndef STACK_QUEUE_QUEUE_H
 #define STACK_QUEUE_QUEUE_H
 
-#include "Stack.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
-class Queue {
+// FIFO queue in a circular buffer: the values live in one array between
+// head_ and head_ + size_, wrapping around its end. Push and Pop are O(1)
+// without the transfers between two stacks, and the array doubles when full.
+// The capacity is a power of two, so wrapping is a mask.
+template <class T>
+class BasicQueue {
 public:
-    void Push(int value);
-    void Pop();
-    size_t Size() const;
-    bool Empty() const;
-    int& Front();
-    int Front() const;
+    BasicQueue() : buffer_(nullptr), head_(0), size_(0), capacity_(0) {
+    }
+
+    BasicQueue(const BasicQueue& other) : BasicQueue() {
+        if (other.size_ == 0) {
+            return;
+        }
+        Reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            Push(other.At(i));
+        }
+    }
+
+    BasicQueue(BasicQueue&& other) noexcept : BasicQueue() {
+        Swap(other);
+    }
+
+    BasicQueue& operator=(BasicQueue other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~BasicQueue() {
+        Clear();
+        Deallocate(buffer_);
+    }
+
+    void Push(const T& value) {
+        Emplace(value);
+    }
+
+    void Push(T&& value) {
+        Emplace(std::move(value));
+    }
+
+    template <class... Args>
+    T& Emplace(Args&&... args) {
+        if (size_ == capacity_) {
+            Reallocate(capacity_ == 0 ? kMinCapacity : 2 * capacity_);
+        }
+        T* slot = new (buffer_ + Index(size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void Pop() {
+        buffer_[head_].~T();
+        head_ = Index(1);
+        --size_;
+    }
+
+    void Clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < size_; ++i) {
+                At(i).~T();
+            }
+        }
+        head_ = 0;
+        size_ = 0;
+    }
+
+    T& Front() {
+        return buffer_[head_];
+    }
+
+    const T& Front() const {
+        return buffer_[head_];
+    }
+
+    T& Back() {
+        return At(size_ - 1);
+    }
+
+    const T& Back() const {
+        return At(size_ - 1);
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    void Reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        size_t new_capacity = capacity_ == 0 ? kMinCapacity : capacity_;
+        while (new_capacity < capacity) {
+            new_capacity *= 2;
+        }
+        if (new_capacity > capacity_) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    void Swap(BasicQueue& other) noexcept {
+        std::swap(buffer_, other.buffer_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
 private:
-    mutable Stack inbox_;
-    mutable Stack outbox_;
+    static const size_t kMinCapacity = 8;
+
+    T* buffer_;
+    size_t head_;
+    size_t size_;
+    size_t capacity_;
+
+    // slot of the value that is offset places behind the front
+    size_t Index(size_t offset) const {
+        return (head_ + offset) & (capacity_ - 1);
+    }
 
-    void MoveFromInToOut() const;
+    T& At(size_t offset) {
+        return buffer_[Index(offset)];
+    }
+
+    const T& At(size_t offset) const {
+        return buffer_[Index(offset)];
+    }
+
+    // aligned for over-aligned T as well
+    static T* Allocate(size_t capacity) {
+        return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    static void Deallocate(T* buffer) {
+        ::operator delete(buffer, std::align_val_t(alignof(T)));
+    }
+
+    // moves the values to the front of a new array, unwrapping them
+    void Reallocate(size_t new_capacity) {
+        T* new_buffer = Allocate(new_capacity);
+        size_t moved = 0;
+        try {
+            for (; moved < size_; ++moved) {
+                new (new_buffer + moved) T(std::move_if_noexcept(At(moved)));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < moved; ++i) {
+                new_buffer[i].~T();
+            }
+            Deallocate(new_buffer);
+            throw;
+        }
+
+        const size_t size = size_;
+        Clear();
+        Deallocate(buffer_);
+        buffer_ = new_buffer;
+        size_ = size;
+        capacity_ = new_capacity;
+    }
 };
 
+// the name the int-only queue had before it became a template
+using Queue = BasicQueue<int>;
+
 #endif //STACK_QUEUE_QUEUE_H
@@ -0,0 +1,288 @@
+#ifndef STACK_QUEUE_RINGQUEUE_H
+#define STACK_QUEUE_RINGQUEUE_H
+
+#include "../lockedShard.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Bounded queues for handing values between threads. Both keep their slots
+// in one ring allocated up front, so no operation allocates, and both round
+// the capacity up to a power of two so that a position maps to its slot
+// with a mask. TryPush/TryPop fail instead of waiting; Push/Pop spin on
+// them and yield to the scheduler while the queue stays full or empty.
+
+inline size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// spins a little, then gives the core away
+class Backoff {
+public:
+    void Pause() {
+        if (spins_ < kSpinLimit) {
+            ++spins_;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static const int kSpinLimit = 64;
+
+    int spins_ = 0;
+};
+
+// One producer thread and one consumer thread. Each side owns its index and
+// keeps a cached copy of the other side's, which it rereads only when the
+// queue looks full (or empty), so the two rarely touch each other's line.
+template <class T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+            : capacity_(RoundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)),
+              mask_(capacity_ - 1),
+              slots_(static_cast<T*>(::operator new(capacity_ * sizeof(T), std::align_val_t(alignof(T))))),
+              head_(0), cached_tail_(0), tail_(0), cached_head_(0) {
+    }
+
+    SpscQueue(const SpscQueue& other) = delete;
+
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    ~SpscQueue() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        for (size_t pos = head_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+            slots_[pos & mask_].~T();
+        }
+        ::operator delete(slots_, std::align_val_t(alignof(T)));
+    }
+
+    bool TryPush(const T& value) {
+        return TryEmplace(value);
+    }
+
+    bool TryPush(T&& value) {
+        return TryEmplace(std::move(value));
+    }
+
+    template <class... Args>
+    bool TryEmplace(Args&&... args) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ == capacity_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity_) {
+                return false;
+            }
+        }
+        new (slots_ + (tail & mask_)) T(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        T* slot = slots_ + (head & mask_);
+        value = std::move(*slot);
+        slot->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void Push(T value) {
+        Backoff backoff;
+        while (!TryPush(std::move(value))) {
+            backoff.Pause();
+        }
+    }
+
+    T Pop() {
+        T value;
+        Backoff backoff;
+        while (!TryPop(value)) {
+            backoff.Pause();
+        }
+        return value;
+    }
+
+    // exact only when called from the producer or the consumer while the
+    // other side is idle
+    size_t Size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    size_t Capacity() const {
+        return capacity_;
+    }
+
+private:
+    const size_t capacity_;
+    const size_t mask_;
+    T* const slots_;
+
+    // consumer side
+    alignas(kCacheLineSize) std::atomic<size_t> head_;
+    size_t cached_tail_;
+    // producer side
+    alignas(kCacheLineSize) std::atomic<size_t> tail_;
+    size_t cached_head_;
+};
+
+// Any number of producers and consumers, after Dmitry Vyukov's bounded
+// MPMC queue. Every slot carries a sequence number telling whose turn it
+// is: a producer at position pos may fill it when the sequence equals pos,
+// a consumer may empty it when the sequence equals pos + 1. Threads claim
+// positions with a CAS on the shared counters, which sit on separate
+// cache lines; the slots themselves are never locked. A value is built
+// only after its slot is claimed, so its constructor must not throw.
+template <class T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(size_t capacity)
+            : capacity_(RoundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)),
+              mask_(capacity_ - 1),
+              cells_(std::make_unique<Cell[]>(capacity_)),
+              enqueue_pos_(0), dequeue_pos_(0) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue& other) = delete;
+
+    MpmcQueue& operator=(const MpmcQueue& other) = delete;
+
+    ~MpmcQueue() {
+        const size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != enqueued; ++pos) {
+            cells_[pos & mask_].Value()->~T();
+        }
+    }
+
+    bool TryPush(const T& value) {
+        return TryEmplace(value);
+    }
+
+    bool TryPush(T&& value) {
+        return TryEmplace(std::move(value));
+    }
+
+    template <class... Args>
+    bool TryEmplace(Args&&... args) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // the slot still holds the value from one lap ago
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->Value()) T(std::forward<Args>(args)...);
+        cell->sequence_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            const size_t sequence = cell->sequence_.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(*cell->Value());
+        cell->Value()->~T();
+        // hand the slot to the producer of the next lap
+        cell->sequence_.store(pos + capacity_, std::memory_order_release);
+        return true;
+    }
+
+    void Push(T value) {
+        Backoff backoff;
+        while (!TryPush(std::move(value))) {
+            backoff.Pause();
+        }
+    }
+
+    T Pop() {
+        T value;
+        Backoff backoff;
+        while (!TryPop(value)) {
+            backoff.Pause();
+        }
+        return value;
+    }
+
+    // a snapshot that may already be stale when it returns
+    size_t Size() const {
+        const size_t enqueued = enqueue_pos_.load(std::memory_order_acquire);
+        const size_t dequeued = dequeue_pos_.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    size_t Capacity() const {
+        return capacity_;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence_;
+        alignas(T) unsigned char storage_[sizeof(T)];
+
+        T* Value() {
+            return std::launder(reinterpret_cast<T*>(storage_));
+        }
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    const std::unique_ptr<Cell[]> cells_;
+
+    alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_;
+    alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_;
+};
+
+#endif //STACK_QUEUE_RINGQUEUE_H
@@ -1,31 +1,67 @@
 #ifndef STACK_QUEUE_STACK_H
 #define STACK_QUEUE_STACK_H
 
-#include <cctype>
+#include "../vector.h"
 
-struct Node;
+#include <cstddef>
+#include <utility>
 
-class Stack {
+// LIFO stack on top of a Vector: Push writes the next slot of one
+// contiguous buffer instead of allocating a node, and the buffer only
+// grows geometrically.
+template <class T>
+class BasicStack {
 public:
-    void Push(int value);
-    void Pop();
-    void Clear();
-    int Top() const;
-    int& Top();
-    bool Empty() const;
-    size_t Size() const;
-
-    Stack();
-    Stack(const Stack &other);
-    Stack& operator=(Stack other);
-    ~Stack();
-
-    void Swap(Stack& other);
-private:
-    Node* top_;
-    size_t size_;
+    void Push(const T& value) {
+        data_.PushBack(value);
+    }
+
+    void Push(T&& value) {
+        data_.PushBack(std::move(value));
+    }
+
+    template <class... Args>
+    T& Emplace(Args&&... args) {
+        return data_.EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    void Pop() {
+        data_.PopBack();
+    }
+
+    void Clear() {
+        data_.Clear();
+    }
+
+    const T& Top() const {
+        return data_.Data()[data_.Size() - 1];
+    }
+
+    T& Top() {
+        return data_.Back();
+    }
 
-    void Reverse();
+    bool Empty() const {
+        return data_.Empty();
+    }
+
+    size_t Size() const {
+        return data_.Size();
+    }
+
+    void Reserve(size_t capacity) {
+        data_.Reserve(capacity);
+    }
+
+    void Swap(BasicStack& other) {
+        data_.Swap(other.data_);
+    }
+
+private:
+    Vector<T> data_;
 };
 
+// the name the int-only stack had before it became a template
+using Stack = BasicStack<int>;
+
 #endif //STACK_QUEUE_STACK_H
@@ -0,0 +1,386 @@
+#include "Rope.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Characters shared by the pieces cut from them. The counts are atomic,
+// since copies of a rope share nodes and buffers but may live on different
+// threads; for the same reason a buffer only grows in place while a single
+// node refers to it.
+struct RopeBuffer {
+    std::atomic<size_t> refs_;
+    String text_;
+};
+
+struct RopeNode {
+    std::atomic<size_t> refs_;
+    RopeBuffer* buffer_;
+    size_t offset_;
+    size_t length_;
+    // characters and nodes in the subtree
+    size_t weight_;
+    size_t count_;
+    RopeNode* left_;
+    RopeNode* right_;
+};
+
+static size_t GetWeight(const RopeNode* node) {
+    return (!node) ? 0 : node->weight_;
+}
+
+static size_t GetCount(const RopeNode* node) {
+    return (!node) ? 0 : node->count_;
+}
+
+static void Update(RopeNode* node) {
+    node->weight_ = GetWeight(node->left_) + GetWeight(node->right_) + node->length_;
+    node->count_ = GetCount(node->left_) + GetCount(node->right_) + 1;
+}
+
+static const char* PieceData(const RopeNode* node) {
+    return node->buffer_->text_.Data() + node->offset_;
+}
+
+static RopeNode* NewNode(RopeBuffer* buffer, size_t offset, size_t length) {
+    buffer->refs_.fetch_add(1, std::memory_order_relaxed);
+    return new RopeNode{1, buffer, offset, length, length, 1, nullptr, nullptr};
+}
+
+static RopeNode* NewNode(const char* str, size_t size, size_t capacity) {
+    RopeBuffer* buffer = new RopeBuffer{0, String()};
+    buffer->text_.Reserve(capacity);
+    buffer->text_.Append(str, size);
+    return NewNode(buffer, 0, size);
+}
+
+static void Ref(RopeNode* node) {
+    if (node) {
+        node->refs_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// whether the caller's reference is the only one; no other thread can
+// take a new one then, since it would need a reference to copy from
+static bool Unshared(const RopeNode* node) {
+    return node->refs_.load(std::memory_order_acquire) == 1;
+}
+
+// drops one reference and frees whatever is no longer referenced
+static void Release(RopeNode* node) {
+    std::vector<RopeNode*> pending;
+    while (node || !pending.empty()) {
+        if (!node) {
+            node = pending.back();
+            pending.pop_back();
+        }
+        if (node->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            node = nullptr;
+            continue;
+        }
+        if (node->right_) {
+            pending.push_back(node->right_);
+        }
+        RopeNode* left = node->left_;
+        if (node->buffer_->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete node->buffer_;
+        }
+        delete node;
+        node = left;
+    }
+}
+
+// the node itself when the caller holds the only reference, otherwise a
+// copy for the caller, whose reference to the original is given up
+static RopeNode* Mutable(RopeNode* node) {
+    if (Unshared(node)) {
+        return node;
+    }
+    RopeNode* copy = NewNode(node->buffer_, node->offset_, node->length_);
+    copy->weight_ = node->weight_;
+    copy->count_ = node->count_;
+    copy->left_ = node->left_;
+    copy->right_ = node->right_;
+    Ref(copy->left_);
+    Ref(copy->right_);
+    // the other owners may have let go meanwhile, so this may be the last
+    Release(node);
+    return copy;
+}
+
+static uint64_t NextRandom() {
+    thread_local uint64_t state = 0x9e3779b97f4a7c15ULL;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// Consumes both trees. Instead of stored priorities the root is drawn with
+// odds proportional to the subtree sizes: shared subtrees would carry
+// their priorities into both ropes (a rope appended to itself would merge
+// equal ones), while the sizes keep the expected depth logarithmic.
+static RopeNode* Merge(RopeNode* left, RopeNode* right) {
+    if (!left) {
+        return right;
+    } else if (!right) {
+        return left;
+    }
+
+    if (NextRandom() % (left->count_ + right->count_) < left->count_) {
+        left = Mutable(left);
+        left->right_ = Merge(left->right_, right);
+        Update(left);
+        return left;
+    }
+    right = Mutable(right);
+    right->left_ = Merge(left, right->left_);
+    Update(right);
+    return right;
+}
+
+// consumes subtree: its first pos characters go to left_tree, the rest to right_tree
+static void Split(size_t pos, RopeNode* subtree, RopeNode*& left_tree, RopeNode*& right_tree) {
+    if (pos == 0 || pos >= GetWeight(subtree)) {
+        left_tree = pos == 0 ? nullptr : subtree;
+        right_tree = pos == 0 ? subtree : nullptr;
+        return;
+    }
+
+    subtree = Mutable(subtree);
+    const size_t curr_pos = GetWeight(subtree->left_);
+    if (pos <= curr_pos) {
+        Split(pos, subtree->left_, left_tree, subtree->left_);
+        right_tree = subtree;
+    } else if (pos >= curr_pos + subtree->length_) {
+        Split(pos - curr_pos - subtree->length_, subtree->right_, subtree->right_, right_tree);
+        left_tree = subtree;
+    } else {
+        // the cut falls inside this piece, its tail becomes a node of its own
+        const size_t cut = pos - curr_pos;
+        RopeNode* tail = NewNode(subtree->buffer_, subtree->offset_ + cut, subtree->length_ - cut);
+        subtree->length_ = cut;
+        right_tree = Merge(tail, subtree->right_);
+        subtree->right_ = nullptr;
+        left_tree = subtree;
+    }
+    Update(subtree);
+}
+
+// whether size more characters fit into the buffer behind the last piece,
+// and nothing on the way there is shared with another rope or piece
+static bool CanExtendLast(const RopeNode* node, size_t size) {
+    for (;; node = node->right_) {
+        if (!Unshared(node)) {
+            return false;
+        }
+        if (!node->right_) {
+            break;
+        }
+    }
+    if (node->buffer_->refs_.load(std::memory_order_acquire) != 1) {
+        return false;
+    }
+    const String& text = node->buffer_->text_;
+    return node->offset_ + node->length_ == text.Size() && text.Size() + size <= Rope::kLeafCapacity;
+}
+
+// appends str to the last piece of a tree CanExtendLast has accepted
+static RopeNode* ExtendLast(RopeNode* node, const char* str, size_t size) {
+    if (node->right_) {
+        node->right_ = ExtendLast(node->right_, str, size);
+    } else {
+        node->buffer_->text_.Append(str, size);
+        node->length_ += size;
+    }
+    Update(node);
+    return node;
+}
+
+template <class Visitor>
+static void ForEachPiece(const RopeNode* node, Visitor& visit) {
+    while (node) {
+        ForEachPiece(node->left_, visit);
+        visit(PieceData(node), node->length_);
+        node = node->right_;
+    }
+}
+
+Rope::Rope() : root_(nullptr) {
+}
+
+Rope::Rope(RopeNode* root) : root_(root) {
+}
+
+Rope::Rope(const char* str) : Rope(str, CStrLen(str)) {
+}
+
+Rope::Rope(const char* str, size_t size) : root_(size == 0 ? nullptr : NewNode(str, size, size)) {
+}
+
+Rope::Rope(const String& str) : Rope(str.Data(), str.Size()) {
+}
+
+Rope::Rope(StringView view) : Rope(view.Data(), view.Size()) {
+}
+
+Rope::Rope(const Rope& other) : root_(other.root_) {
+    Ref(root_);
+}
+
+Rope::Rope(Rope&& other) noexcept : root_(other.root_) {
+    other.root_ = nullptr;
+}
+
+Rope& Rope::operator=(const Rope& other) {
+    Ref(other.root_);
+    Release(root_);
+    root_ = other.root_;
+    return *this;
+}
+
+Rope& Rope::operator=(Rope&& other) noexcept {
+    Swap(other);
+    return *this;
+}
+
+Rope::~Rope() {
+    Release(root_);
+}
+
+size_t Rope::Size() const {
+    return GetWeight(root_);
+}
+
+size_t Rope::Length() const {
+    return GetWeight(root_);
+}
+
+bool Rope::Empty() const {
+    return root_ == nullptr;
+}
+
+void Rope::Clear() {
+    Release(root_);
+    root_ = nullptr;
+}
+
+void Rope::Swap(Rope& other) {
+    std::swap(root_, other.root_);
+}
+
+char Rope::operator[](size_t idx) const {
+    const RopeNode* node = root_;
+    for (;;) {
+        const size_t curr_pos = GetWeight(node->left_);
+        if (idx < curr_pos) {
+            node = node->left_;
+        } else if (idx < curr_pos + node->length_) {
+            return PieceData(node)[idx - curr_pos];
+        } else {
+            idx -= curr_pos + node->length_;
+            node = node->right_;
+        }
+    }
+}
+
+Rope& Rope::operator+=(const Rope& other) {
+    Ref(other.root_);
+    root_ = Merge(root_, other.root_);
+    return *this;
+}
+
+Rope& Rope::operator+=(const String& str) {
+    Append(str.Data(), str.Size());
+    return *this;
+}
+
+Rope& Rope::operator+=(const char* str) {
+    Append(str, CStrLen(str));
+    return *this;
+}
+
+Rope& Rope::operator+=(StringView view) {
+    Append(view.Data(), view.Size());
+    return *this;
+}
+
+Rope& Rope::operator+=(char symbol) {
+    Append(&symbol, 1);
+    return *this;
+}
+
+void Rope::Append(const char* str, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    if (root_ && CanExtendLast(root_, size)) {
+        root_ = ExtendLast(root_, str, size);
+    } else {
+        root_ = Merge(root_, NewNode(str, size, size < kLeafCapacity ? kLeafCapacity : size));
+    }
+}
+
+void Rope::Insert(size_t pos, const Rope& other) {
+    RopeNode* left = nullptr;
+    RopeNode* right = nullptr;
+    Ref(other.root_);
+    Split(pos, root_, left, right);
+    root_ = Merge(Merge(left, other.root_), right);
+}
+
+void Rope::Erase(size_t pos, size_t count) {
+    RopeNode* left = nullptr;
+    RopeNode* mid = nullptr;
+    RopeNode* to_delete = nullptr;
+    RopeNode* right = nullptr;
+    Split(pos, root_, left, mid);
+    Split(count, mid, to_delete, right);
+    Release(to_delete);
+    root_ = Merge(left, right);
+}
+
+Rope Rope::Substr(size_t pos, size_t count) const {
+    RopeNode* left = nullptr;
+    RopeNode* mid = nullptr;
+    RopeNode* result = nullptr;
+    RopeNode* right = nullptr;
+    Ref(root_);
+    Split(pos, root_, left, mid);
+    Release(left);
+    Split(count, mid, result, right);
+    Release(right);
+    return Rope(result);
+}
+
+String Rope::ToString() const {
+    String result;
+    result.Reserve(Size());
+    auto append = [&result](const char* data, size_t size) {
+        result.Append(data, size);
+    };
+    ForEachPiece(root_, append);
+    return result;
+}
+
+void Rope::Flatten() {
+    if (root_ && (root_->left_ || root_->right_)) {
+        RopeBuffer* buffer = new RopeBuffer{0, ToString()};
+        Release(root_);
+        root_ = NewNode(buffer, 0, buffer->text_.Size());
+    }
+}
+
+Rope operator+(Rope lhs, const Rope& rhs) {
+    lhs += rhs;
+    return lhs;
+}
+
+std::ostream& operator<<(std::ostream& os, const Rope& rope) {
+    auto write = [&os](const char* data, size_t size) {
+        os.write(data, static_cast<std::streamsize>(size));
+    };
+    ForEachPiece(rope.root_, write);
+    return os;
+}
@@ -0,0 +1,73 @@
+#ifndef STRING_ROPE_HPP
+#define STRING_ROPE_HPP
+
+#include "String.hpp"
+
+#include <iostream>
+
+struct RopeNode;
+
+// Text kept as an implicit-key treap of pieces, each piece a range of a
+// buffer, ordered as in SuperVector but split by character position.
+// Concatenation, Insert, Erase and Substr cost O(log n) and copy no
+// characters: nodes are shared between ropes and an edit copies only the
+// nodes on its path unless it holds the only reference. Copying a rope is
+// O(1), and copies may be used on different threads like separate strings.
+// Small appends go into the last piece's buffer while it has room and no
+// other piece uses it, so text built a few characters at a time does not
+// end up one node per append. Positions past the end are clamped to Size().
+class Rope {
+public:
+    Rope();
+    Rope(const char* str);
+    Rope(const char* str, size_t size);
+    Rope(const String& str);
+    Rope(StringView view);
+
+    Rope(const Rope& other);
+    Rope(Rope&& other) noexcept;
+    Rope& operator=(const Rope& other);
+    Rope& operator=(Rope&& other) noexcept;
+    ~Rope();
+
+    size_t Size() const;
+    size_t Length() const;
+    bool Empty() const;
+    void Clear();
+    void Swap(Rope& other);
+
+    // O(log n)
+    char operator[](size_t idx) const;
+
+    Rope& operator+=(const Rope& other);
+    Rope& operator+=(const String& str);
+    Rope& operator+=(const char* str);
+    Rope& operator+=(StringView view);
+    Rope& operator+=(char symbol);
+    void Append(const char* str, size_t size);
+
+    void Insert(size_t pos, const Rope& other);
+    void Erase(size_t pos, size_t count);
+    Rope Substr(size_t pos, size_t count = String::kNpos) const;
+
+    // the whole text in one String, O(n)
+    String ToString() const;
+    // replaces the pieces by a single one, so that later reads touch one buffer
+    void Flatten();
+
+    // a fresh buffer for appended text reserves this much
+    const static size_t kLeafCapacity = 1024;
+
+private:
+    friend std::ostream& operator<<(std::ostream& os, const Rope& rope);
+
+    RopeNode* root_;
+
+    explicit Rope(RopeNode* root);
+};
+
+Rope operator+(Rope lhs, const Rope& rhs);
+
+std::ostream& operator<<(std::ostream& os, const Rope& rope);
+
+#endif //STRING_ROPE_HPP
@@ -1,47 +1,308 @@
 #include "String.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <locale>
+#include <streambuf>
+#include <utility>
 
-size_t CStrLen(const char* input_str) {
-    size_t length = 0;
-    while (input_str[length] != '\0') {
-        ++length;
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// The byte loops below work on kWidth bytes at a time. A comparison yields
+// a mask with one bit per byte (the bit of byte i sits at i << kShift), so
+// that the first and last matching bytes fall out of a bit scan.
+
+#if defined(__AVX2__)
+
+struct Block {
+    static const size_t kWidth = 32;
+    static const int kShift = 0;
+    static const uint64_t kAll = 0xffffffffULL;
+
+    __m256i bytes_;
+
+    static Block Load(const char* pos) {
+        return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))};
     }
 
-    return length;
-}
+    static Block Fill(char symbol) {
+        return {_mm256_set1_epi8(symbol)};
+    }
 
-static void BufferCopy(const char* from, char* to, size_t amount) {
-    for (size_t i = 0; i < amount; ++i) {
-        to[i] = from[i];
+    uint64_t Equal(const Block& other) const {
+        return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes_, other.bytes_)));
+    }
+};
+
+#elif defined(__SSE2__)
+
+struct Block {
+    static const size_t kWidth = 16;
+    static const int kShift = 0;
+    static const uint64_t kAll = 0xffffULL;
+
+    __m128i bytes_;
+
+    static Block Load(const char* pos) {
+        return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))};
+    }
+
+    static Block Fill(char symbol) {
+        return {_mm_set1_epi8(symbol)};
+    }
+
+    uint64_t Equal(const Block& other) const {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes_, other.bytes_)));
+    }
+};
+
+#else
+
+// eight bytes handled at once inside a 64-bit word, byte i in bits 8i..8i+7
+struct Block {
+    static const size_t kWidth = 8;
+    static const int kShift = 3;
+    static const uint64_t kAll = 0x8080808080808080ULL;
+
+    static const uint64_t kLsbs = 0x0101010101010101ULL;
+    static const uint64_t kLows = 0x7f7f7f7f7f7f7f7fULL;
+
+    uint64_t bytes_;
+
+    static Block Load(const char* pos) {
+        Block block;
+        std::memcpy(&block.bytes_, pos, sizeof(block.bytes_));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        block.bytes_ = __builtin_bswap64(block.bytes_);
+#endif
+        return block;
+    }
+
+    static Block Fill(char symbol) {
+        return {kLsbs * static_cast<unsigned char>(symbol)};
     }
 
+    // exact: adding 0x7f carries into the top bit of every nonzero byte
+    uint64_t Equal(const Block& other) const {
+        const uint64_t diff = bytes_ ^ other.bytes_;
+        return ~(((diff & kLows) + kLows) | diff | kLows);
+    }
+};
+
+#endif
+
+size_t LowestByte(uint64_t mask) {
+    return static_cast<size_t>(__builtin_ctzll(mask)) >> Block::kShift;
+}
+
+size_t HighestByte(uint64_t mask) {
+    return static_cast<size_t>(63 - __builtin_clzll(mask)) >> Block::kShift;
+}
+
+uint64_t WithoutHighest(uint64_t mask) {
+    return mask & ~(uint64_t(1) << (63 - __builtin_clzll(mask)));
+}
+
+}  // namespace
+
+// Length, copy and fill go to the C library, whose versions are already
+// vectorized and picked for the running CPU; GCC turned the plain loops
+// these used to be into the same calls.
+
+size_t CStrLen(const char* input_str) {
+    return std::strlen(input_str);
+}
+
+static void BufferCopy(const char* from, char* to, size_t amount) {
+    std::memcpy(to, from, amount);
     to[amount] = '\0';
 }
 
 void FillWith(char symbol, const size_t size, char* c_string) {
-    for (size_t i = 0; i < size; ++i) {
-        c_string[i] = symbol;
-    }
+    std::memset(c_string, symbol, size);
     c_string[size] = '\0';
 }
 
+size_t MismatchIndex(const char* first, const char* second, size_t size) {
+    size_t i = 0;
+    for (; i + Block::kWidth <= size; i += Block::kWidth) {
+        const uint64_t differ = ~Block::Load(first + i).Equal(Block::Load(second + i)) & Block::kAll;
+        if (differ != 0) {
+            return i + LowestByte(differ);
+        }
+    }
+    for (; i < size && first[i] == second[i]; ++i) {
+    }
+
+    return i;
+}
+
+size_t FindByte(const char* data, size_t size, char symbol) {
+    const void* found = std::memchr(data, symbol, size);
+    return found == nullptr ? StringView::kNpos : static_cast<size_t>(static_cast<const char*>(found) - data);
+}
+
+size_t FindLastByte(const char* data, size_t size, char symbol) {
+    const Block needle = Block::Fill(symbol);
+    size_t end = size;
+    for (; end >= Block::kWidth; end -= Block::kWidth) {
+        const uint64_t mask = Block::Load(data + end - Block::kWidth).Equal(needle);
+        if (mask != 0) {
+            return end - Block::kWidth + HighestByte(mask);
+        }
+    }
+    while (end > 0) {
+        if (data[--end] == symbol) {
+            return end;
+        }
+    }
+
+    return StringView::kNpos;
+}
+
+// A candidate position must match both the first and the last byte of the
+// pattern; the two are tested for a whole block of positions at once and
+// only the survivors are compared in full.
+size_t FindBytes(const char* data, size_t size, const char* pattern, size_t pattern_size) {
+    if (pattern_size == 0) {
+        return 0;
+    }
+    if (pattern_size > size) {
+        return StringView::kNpos;
+    }
+    if (pattern_size == 1) {
+        return FindByte(data, size, pattern[0]);
+    }
+
+    const size_t last = pattern_size - 1;
+    const Block first_byte = Block::Fill(pattern[0]);
+    const Block last_byte = Block::Fill(pattern[last]);
+    size_t i = 0;
+    for (; i + last + Block::kWidth <= size; i += Block::kWidth) {
+        uint64_t mask = Block::Load(data + i).Equal(first_byte) & Block::Load(data + i + last).Equal(last_byte);
+        while (mask != 0) {
+            const size_t candidate = i + LowestByte(mask);
+            if (MismatchIndex(data + candidate + 1, pattern + 1, last - 1) == last - 1) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; i + last < size; ++i) {
+        if (data[i] == pattern[0] && MismatchIndex(data + i + 1, pattern + 1, last) == last) {
+            return i;
+        }
+    }
+
+    return StringView::kNpos;
+}
+
+size_t FindLastBytes(const char* data, size_t size, const char* pattern, size_t pattern_size) {
+    if (pattern_size > size) {
+        return StringView::kNpos;
+    }
+    if (pattern_size == 0) {
+        return size;
+    }
+    if (pattern_size == 1) {
+        return FindLastByte(data, size, pattern[0]);
+    }
+
+    const size_t last = pattern_size - 1;
+    const Block first_byte = Block::Fill(pattern[0]);
+    const Block last_byte = Block::Fill(pattern[last]);
+    // candidates are the positions below end
+    size_t end = size - last;
+    for (; end >= Block::kWidth; end -= Block::kWidth) {
+        const size_t i = end - Block::kWidth;
+        uint64_t mask = Block::Load(data + i).Equal(first_byte) & Block::Load(data + i + last).Equal(last_byte);
+        while (mask != 0) {
+            const size_t offset = HighestByte(mask);
+            if (MismatchIndex(data + i + offset + 1, pattern + 1, last - 1) == last - 1) {
+                return i + offset;
+            }
+            mask = WithoutHighest(mask);
+        }
+    }
+    while (end > 0) {
+        --end;
+        if (data[end] == pattern[0] && MismatchIndex(data + end + 1, pattern + 1, last) == last) {
+            return end;
+        }
+    }
+
+    return StringView::kNpos;
+}
+
+char* String::AllocateBuffer(size_t capacity) {
+    return static_cast<char*>(resource_->Allocate(capacity + 1, alignof(char)));
+}
+
+void String::FreeBuffer() {
+    if (!IsInline()) {
+        resource_->Deallocate(buffer_, capacity_ + 1, alignof(char));
+    }
+}
+
+bool String::IsInline() const {
+    return buffer_ == inline_;
+}
+
+// capacity_ shares its bytes with inline_, so it is written only after the
+// characters have left inline_ and read only before they are moved into it
 void String::Reallocate(size_t new_cap) {
-    char* newBuffer = new char[new_cap + 1];
+    if (new_cap <= kInlineCapacity) {
+        if (!IsInline()) {
+            char* old_buffer = buffer_;
+            const size_t old_capacity = capacity_;
+            BufferCopy(old_buffer, inline_, size_);
+            buffer_ = inline_;
+            resource_->Deallocate(old_buffer, old_capacity + 1, alignof(char));
+        }
+        return;
+    }
+
+    char* newBuffer = AllocateBuffer(new_cap);
 
     BufferCopy(buffer_, newBuffer, size_);
 
-    delete[] buffer_;
+    FreeBuffer();
     buffer_ = newBuffer;
     capacity_ = new_cap;
 }
 
-void String::PushBack(char symbol) {
-    if (size_ >= capacity_ && capacity_ != 0) {
-        Reallocate(kIncreaseFactor * capacity_);
-    } else if (capacity_ == 0) {
-        Reallocate(1);
+void String::Grow(size_t required) {
+    const size_t capacity = Capacity();
+    if (required > capacity) {
+        Reallocate(std::max(required, kIncreaseFactor * capacity));
     }
+}
+
+void String::StealFrom(String& other) {
+    resource_ = other.resource_;
+    size_ = other.size_;
+    if (other.IsInline()) {
+        buffer_ = inline_;
+        BufferCopy(other.inline_, inline_, other.size_);
+    } else {
+        buffer_ = other.buffer_;
+        capacity_ = other.capacity_;
+        other.buffer_ = other.inline_;
+    }
+    other.size_ = 0;
+    other.inline_[0] = '\0';
+}
+
+void String::PushBack(char symbol) {
+    Grow(size_ + 1);
 
     buffer_[size_] = symbol;
     buffer_[size_ + 1] = '\0';
@@ -64,7 +325,7 @@ size_t String::Length() const {
 }
 
 size_t String::Capacity() const {
-    return capacity_;
+    return IsInline() ? kInlineCapacity : capacity_;
 }
 
 char& String::Back() {
@@ -84,10 +345,8 @@ const char& String::Front() const {
 }
 
 void String::Resize(size_t new_size, char fill) {
-    if (new_size > size_ && new_size > capacity_) {
-        Reallocate(new_size);
-        FillWith(fill, new_size - size_, buffer_ + size_);
-    } else if(new_size > size_ && new_size <= capacity_) {
+    if (new_size > size_) {
+        Reserve(new_size);
         FillWith(fill, new_size - size_, buffer_ + size_);
     }
 
@@ -96,13 +355,13 @@ void String::Resize(size_t new_size, char fill) {
 }
 
 void String::ShrinkToFit() {
-    if (capacity_ > size_) {
+    if (!IsInline() && capacity_ > size_) {
         Reallocate(size_);
     }
 }
 
 void String::Reserve(size_t new_capacity) {
-    if (new_capacity > capacity_) {
+    if (new_capacity > Capacity()) {
         Reallocate(new_capacity);
     }
 }
@@ -119,59 +378,107 @@ const char* String::Data() const {
     return buffer_;
 }
 
+String::operator StringView() const {
+    return StringView(buffer_, size_);
+}
+
+MemoryResource* String::GetResource() const {
+    return resource_;
+}
+
 void String::Clear() {
     buffer_[0] = '\0';
     size_ = 0;
 }
 
-static int StringCompare(const String& first, const String& second) {
-    for (size_t i = 0; i < first.Size() && i < second.Size(); ++i) {
-        if (first[i] != second[i]) {
-            return (static_cast<int>(first[i]) - static_cast<int>(second[i]));
-        }
-    }
+size_t String::Find(char symbol, size_t pos) const {
+    return StringView(*this).Find(symbol, pos);
+}
+
+size_t String::Find(StringView pattern, size_t pos) const {
+    return StringView(*this).Find(pattern, pos);
+}
+
+size_t String::RFind(char symbol, size_t pos) const {
+    return StringView(*this).RFind(symbol, pos);
+}
 
-    return static_cast<int>(first.Length()) - static_cast<int>(second.Length());
+size_t String::RFind(StringView pattern, size_t pos) const {
+    return StringView(*this).RFind(pattern, pos);
 }
 
 void String::Swap(String &other) {
-    std::swap(size_, other.size_);
-    std::swap(capacity_, other.capacity_);
-    std::swap(buffer_, other.buffer_);
+    if (this == &other) {
+        return;
+    }
+    String tmp(std::move(other));
+    other.StealFrom(*this);
+    StealFrom(tmp);
 }
 
-String::String() : size_(0), capacity_(0) {
-    buffer_ = new char[capacity_ + 1];
-    buffer_[capacity_] = '\0';
+String::String() : String(DefaultResource()) {
+}
+
+String::String(MemoryResource* resource) : resource_(resource), buffer_(inline_), size_(0) {
+    inline_[0] = '\0';
 }
 
 String::String(const char* str) : String(str, CStrLen(str)) {
 }
 
-String::String(const char* str, size_t size) : size_(size), capacity_(CStrLen(str)) {
-    buffer_ = new char[capacity_ + 1];
+String::String(const char* str, size_t size) : String(str, size, DefaultResource()) {
+}
+
+String::String(const char* str, size_t size, MemoryResource* resource) : String(resource) {
+    Reserve(size);
     BufferCopy(str, buffer_, size);
+    size_ = size;
+}
+
+String::String(StringView view) : String(view.Data(), view.Size()) {
+}
+
+String::String(size_t size, char symbol) : String(DefaultResource()) {
+    Reserve(size);
+    FillWith(symbol, size, buffer_);
+    size_ = size;
+}
+
+String::String(const String& other) : String(other, other.resource_) {
 }
 
-String::String(size_t size, char symbol) : size_(size), capacity_(size) {
-    buffer_ = new char[capacity_ + 1];
-    FillWith(symbol, size_, buffer_);
+String::String(const String& other, MemoryResource* resource) : String(other.buffer_, other.size_, resource) {
 }
 
-String::String(const String& other) : size_(other.size_), capacity_(other.capacity_) {
-    buffer_ = new char[capacity_ + 1];
-    BufferCopy(other.buffer_, buffer_, size_);
+// the moved-from string is left empty and keeps its resource
+String::String(String&& other) noexcept {
+    StealFrom(other);
 }
 
-String& String::operator=(String other) {
-    Swap(other);
+// reuses the buffer when the resource is the same and the copy fits
+String& String::operator=(const String& other) {
+    if (this == &other) {
+        return *this;
+    }
+    if (resource_ == other.resource_ && other.size_ <= Capacity()) {
+        BufferCopy(other.buffer_, buffer_, other.size_);
+        size_ = other.size_;
+    } else {
+        String(other).Swap(*this);
+    }
     return *this;
 }
 
-String& String::operator+=(const String& other) {
-    if (capacity_ <= size_ + other.size_) {
-        Reallocate(capacity_ + other.size_);
+String& String::operator=(String&& other) noexcept {
+    if (this != &other) {
+        FreeBuffer();
+        StealFrom(other);
     }
+    return *this;
+}
+
+String& String::operator+=(const String& other) {
+    Grow(size_ + other.size_);
 
     BufferCopy(other.buffer_, buffer_ + size_, other.size_);
     size_ += other.size_;
@@ -185,16 +492,26 @@ String& String::operator+=(char symbol) {
 }
 
 String& String::operator+=(const char* str) {
-    const size_t size = CStrLen(str);
+    Append(str, CStrLen(str));
+    return *this;
+}
 
-    if (capacity_ <= size_ + size) {
-        Reallocate(capacity_ + size);
+String& String::operator+=(StringView view) {
+    Append(view.Data(), view.Size());
+    return *this;
+}
+
+void String::Append(const char* str, size_t size) {
+    if (str >= buffer_ && str <= buffer_ + size_) {
+        const size_t offset = str - buffer_;
+        Grow(size_ + size);
+        str = buffer_ + offset;
+    } else {
+        Grow(size_ + size);
     }
 
     BufferCopy(str, buffer_ + size_, size);
     size_ += size;
-
-    return *this;
 }
 
 char& String::operator[](size_t idx) {
@@ -206,36 +523,46 @@ char String::operator[](size_t idx) const {
 }
 
 String::~String() {
-    delete[] buffer_;
+    FreeBuffer();
 }
 
+// lhs is returned by name so that it is moved out, not copied
 String operator+(String lhs, const String& rhs) {
-    return lhs += rhs;
+    lhs += rhs;
+    return lhs;
 }
 
 String operator+(String lhs, const char& rhs) {
-    return lhs += rhs;
+    lhs += rhs;
+    return lhs;
 }
 
 String operator+(String lhs, const char* rhs) {
-    return lhs += rhs;
+    lhs += rhs;
+    return lhs;
+}
+
+String operator+(String lhs, StringView rhs) {
+    lhs += rhs;
+    return lhs;
 }
 
 String operator+(char lhs, const String& rhs) {
     String tmp_str(1, lhs);
-    return tmp_str += rhs;
+    tmp_str += rhs;
+    return tmp_str;
 }
 
 bool operator==(const String& lhs, const String& rhs) {
-    return StringCompare(lhs, rhs) == 0;
+    return StringView(lhs) == StringView(rhs);
 }
 
 bool operator<(const String& lhs, const String& rhs) {
-    return StringCompare(lhs, rhs) < 0;
+    return StringView(lhs).Compare(rhs) < 0;
 }
 
 bool operator>(const String& lhs, const String& rhs) {
-    return StringCompare(lhs, rhs) > 0;
+    return StringView(lhs).Compare(rhs) > 0;
 }
 
 bool operator>=(const String& lhs, const String& rhs) {
@@ -255,13 +582,59 @@ std::ostream& operator<<(std::ostream& os, const String& out_str) {
     return os;
 }
 
+// Works like the std::string extractor: skips leading whitespace, replaces
+// the contents and stops at whitespace, at the end of input or after
+// width() characters. Characters are taken with sgetc/snextc, which stay
+// inline while the streambuf has buffered input, and collected in a local
+// chunk that is appended at once instead of one PushBack each. A token
+// longer than the chunk reserves kReadReserve and grows geometrically.
 std::istream& operator>>(std::istream& is, String& input_str) {
-    char symb = getchar();
+    const std::istream::sentry sentry(is);
+    if (!sentry) {
+        return is;
+    }
 
-    while (!isspace(symb) && symb != '\n') {
-        input_str.PushBack(symb);
-        symb = getchar();
+    using Traits = std::istream::traits_type;
+    const std::ctype<char>& ctype = std::use_facet<std::ctype<char>>(is.getloc());
+    std::streambuf* buf = is.rdbuf();
+    const size_t limit = is.width() > 0 ? static_cast<size_t>(is.width()) : String::kNpos;
+    size_t extracted = 0;
+    std::ios_base::iostate state = std::ios_base::goodbit;
+
+    const size_t kChunkSize = 256;
+    char chunk[kChunkSize];
+
+    input_str.Clear();
+    Traits::int_type next = buf->sgetc();
+    bool stopped = false;
+    while (!stopped && extracted < limit) {
+        const size_t room = std::min(kChunkSize, limit - extracted);
+        size_t filled = 0;
+        for (; filled < room; ++filled) {
+            if (Traits::eq_int_type(next, Traits::eof())) {
+                state |= std::ios_base::eofbit;
+                stopped = true;
+                break;
+            }
+            const char symbol = Traits::to_char_type(next);
+            if (ctype.is(std::ctype_base::space, symbol)) {
+                stopped = true;
+                break;
+            }
+            chunk[filled] = symbol;
+            next = buf->snextc();
+        }
+        if (extracted == kChunkSize) {
+            input_str.Reserve(String::kReadReserve);
+        }
+        input_str.Append(chunk, filled);
+        extracted += filled;
     }
 
+    is.width(0);
+    if (extracted == 0) {
+        state |= std::ios_base::failbit;
+    }
+    is.setstate(state);
     return is;
-}
\ No newline at end of file
+}
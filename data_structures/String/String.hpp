@@ -1,6 +1,9 @@
 #ifndef STRING_STRING_HPP
 #define STRING_STRING_HPP
 
+#include "../allocators.h"
+#include "StringView.hpp"
+
 #include <cctype>
 
 #include <iostream>
@@ -11,14 +14,22 @@ public:
     String(const char* str);
     String(const char* str, size_t size);
     String(size_t size, char symbol);
+    explicit String(StringView view);
+
+    // the buffer is drawn from resource instead of the global heap
+    explicit String(MemoryResource* resource);
+    String(const char* str, size_t size, MemoryResource* resource);
+    String(const String& other, MemoryResource* resource);
 
     String(const String& other);
-    String& operator=(String other);
+    String(String&& other) noexcept;
+    String& operator=(const String& other);
+    String& operator=(String&& other) noexcept;
     ~String();
 
     size_t Size() const;
     size_t Length() const;
-    // without null terminator
+    // without null terminator; at least kInlineCapacity
     size_t Capacity() const;
     void Resize(size_t new_size, char fill = char());
     bool Empty() const;
@@ -38,30 +49,61 @@ public:
 
     const char* CStr() const;
     const char* Data() const;
+    // valid until the string is changed or destroyed
+    operator StringView() const;
+    MemoryResource* GetResource() const;
 
     String& operator+=(const String& other);
     String& operator+=(const char* str);
+    String& operator+=(StringView view);
     String& operator+=(char symbol);
 
+    // str may point into this string
+    void Append(const char* str, size_t size);
     void PushBack(char symbol);
     void PopBack();
 
+    // position of the first occurrence at or after pos, kNpos if there is none
+    size_t Find(char symbol, size_t pos = 0) const;
+    size_t Find(StringView pattern, size_t pos = 0) const;
+    // position of the last occurrence that starts at or before pos
+    size_t RFind(char symbol, size_t pos = kNpos) const;
+    size_t RFind(StringView pattern, size_t pos = kNpos) const;
+
+    const static size_t kNpos = StringView::kNpos;
+    // what operator>> reserves once a word is longer than the chunk it reads in
+    const static size_t kReadReserve = 4096;
+
+    // strings up to this length are kept inside the object, without allocating
+    const static size_t kInlineCapacity = 23;
+
 private:
+    MemoryResource* resource_;
+    // points to inline_ for short strings, to a heap buffer otherwise
     char* buffer_;
     size_t size_;
-    size_t capacity_;
+    union {
+        // capacity of the heap buffer, without null terminator
+        size_t capacity_;
+        char inline_[kInlineCapacity + 1];
+    };
 
     const static size_t kIncreaseFactor = 2;
 
+    bool IsInline() const;
     void Reallocate(size_t new_cap);
+    // makes room for at least required characters, growing geometrically
+    void Grow(size_t required);
+    void StealFrom(String& other);
+    char* AllocateBuffer(size_t capacity);
+    void FreeBuffer();
 };
 
-size_t CStrLen(const char* str);
-
 String operator+(String lhs, const String& rhs);
 String operator+(String lhs, const char* rhs);
 String operator+(char lhs, const String& rhs);
 String operator+(String lhs, const char& rhs);
+String operator+(String lhs, StringView rhs);
 
 bool operator==(const String& lhs, const String& rhs);
 bool operator>=(const String& lhs, const String& rhs);
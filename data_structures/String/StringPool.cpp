@@ -0,0 +1,120 @@
+#include "StringPool.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+// what the default handle and every empty string point to
+struct EmptyEntry {
+    InternedEntry entry_;
+    char terminator_;
+};
+
+static_assert(offsetof(EmptyEntry, terminator_) == sizeof(InternedEntry),
+              "the terminator must sit where InternedEntry::Data looks");
+
+static const EmptyEntry kEmptyEntry = {{0, 0}, '\0'};
+
+InternedString::InternedString() : entry_(&kEmptyEntry.entry_) {
+}
+
+StringPool::StringPool(size_t shard_count)
+        : shard_bits_(ShardBits(shard_count)), shards_(std::make_unique<Shard[]>(size_t(1) << shard_bits_)) {
+}
+
+StringPool::~StringPool() = default;
+
+InternedString StringPool::Intern(const char* str) {
+    return Intern(str, CStrLen(str));
+}
+
+InternedString StringPool::Intern(const String& str) {
+    return Intern(str.Data(), str.Size());
+}
+
+InternedString StringPool::Intern(StringView view) {
+    return Intern(view.Data(), view.Size());
+}
+
+InternedString StringPool::Intern(const char* str, size_t size) {
+    if (size == 0) {
+        return InternedString();
+    }
+
+    const uint64_t hash = HashBytes(str, size);
+    Shard& shard = ShardFor(hash);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+        if (const InternedEntry* found = Find(shard.data_, hash, str, size)) {
+            return InternedString(found);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+    // another thread may have interned it while no lock was held
+    if (const InternedEntry* found = Find(shard.data_, hash, str, size)) {
+        return InternedString(found);
+    }
+
+    void* memory = shard.data_.arena_.Allocate(sizeof(InternedEntry) + size + 1, alignof(InternedEntry));
+    InternedEntry* entry = new (memory) InternedEntry{hash, size};
+    char* data = reinterpret_cast<char*>(entry + 1);
+    std::memcpy(data, str, size);
+    data[size] = '\0';
+
+    Insert(shard.data_, entry);
+    return InternedString(entry);
+}
+
+size_t StringPool::Size() const {
+    size_t count = 0;
+    for (size_t i = 0; i < ShardCount(); ++i) {
+        std::shared_lock<std::shared_mutex> lock(shards_[i].mutex_);
+        count += shards_[i].data_.size_;
+    }
+    return count;
+}
+
+size_t StringPool::ShardCount() const {
+    return size_t(1) << shard_bits_;
+}
+
+StringPool::Shard& StringPool::ShardFor(uint64_t hash) {
+    return shards_[ShardOfHash(hash, shard_bits_)];
+}
+
+const InternedEntry* StringPool::Find(const Table& table, uint64_t hash, const char* str, size_t size) {
+    if (table.slots_.empty()) {
+        return nullptr;
+    }
+    const size_t mask = table.slots_.size() - 1;
+    for (size_t idx = hash & mask; table.slots_[idx] != nullptr; idx = (idx + 1) & mask) {
+        const InternedEntry* entry = table.slots_[idx];
+        if (entry->hash_ == hash && entry->size_ == size && std::memcmp(entry->Data(), str, size) == 0) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+void StringPool::Insert(Table& table, const InternedEntry* entry) {
+    if (2 * (table.size_ + 1) > table.slots_.size()) {
+        std::vector<const InternedEntry*> old_slots(table.slots_.empty() ? 16 : 2 * table.slots_.size(), nullptr);
+        old_slots.swap(table.slots_);
+        table.size_ = 0;
+        for (const InternedEntry* old_entry : old_slots) {
+            if (old_entry != nullptr) {
+                Insert(table, old_entry);
+            }
+        }
+    }
+
+    const size_t mask = table.slots_.size() - 1;
+    size_t idx = entry->hash_ & mask;
+    while (table.slots_[idx] != nullptr) {
+        idx = (idx + 1) & mask;
+    }
+    table.slots_[idx] = entry;
+    ++table.size_;
+}
@@ -0,0 +1,128 @@
+#ifndef STRING_STRINGPOOL_HPP
+#define STRING_STRINGPOOL_HPP
+
+#include "../allocators.h"
+#include "../hash64.h"
+#include "../lockedShard.h"
+#include "String.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+// header of an interned string, its characters and terminator follow it
+struct InternedEntry {
+    uint64_t hash_;
+    size_t size_;
+
+    const char* Data() const {
+        return reinterpret_cast<const char*>(this + 1);
+    }
+};
+
+// Handle to a string stored once in a StringPool. Equal contents interned
+// in the same pool give the same entry, so comparison is a pointer compare
+// and the hash is read, not computed. Handles from different pools must
+// not be compared, and none may outlive its pool. The default handle is
+// the empty string, which every pool maps to as well.
+class InternedString {
+public:
+    InternedString();
+
+    const char* CStr() const {
+        return entry_->Data();
+    }
+
+    const char* Data() const {
+        return entry_->Data();
+    }
+
+    size_t Size() const {
+        return entry_->size_;
+    }
+
+    bool Empty() const {
+        return entry_->size_ == 0;
+    }
+
+    uint64_t Hash() const {
+        return entry_->hash_;
+    }
+
+    String ToString() const {
+        return String(Data(), Size());
+    }
+
+    operator StringView() const {
+        return StringView(Data(), Size());
+    }
+
+    bool operator==(const InternedString& other) const {
+        return entry_ == other.entry_;
+    }
+
+    bool operator!=(const InternedString& other) const {
+        return entry_ != other.entry_;
+    }
+
+private:
+    friend class StringPool;
+
+    const InternedEntry* entry_;
+
+    explicit InternedString(const InternedEntry* entry) : entry_(entry) {
+    }
+};
+
+template <>
+struct Hash64<InternedString> {
+    uint64_t operator()(const InternedString& key) const {
+        return key.Hash();
+    }
+};
+
+// Deduplicating store of strings, safe to intern into from many threads.
+// Entries are split into shards by ShardOfHash, each with its own lock,
+// arena and open-addressing table of entries. A string that is
+// already present is found under a shared lock; entries never move or die
+// before the pool does, so handles are read without any lock.
+class StringPool {
+public:
+    explicit StringPool(size_t shard_count = 16);
+
+    StringPool(const StringPool& other) = delete;
+
+    StringPool& operator=(const StringPool& other) = delete;
+
+    ~StringPool();
+
+    InternedString Intern(const char* str, size_t size);
+    InternedString Intern(const char* str);
+    InternedString Intern(const String& str);
+    InternedString Intern(StringView view);
+
+    // number of distinct strings; not a snapshot, shards are counted one after another
+    size_t Size() const;
+
+    size_t ShardCount() const;
+
+private:
+    struct Table {
+        Arena arena_;
+        // power-of-two sized, at most half full
+        std::vector<const InternedEntry*> slots_;
+        size_t size_ = 0;
+    };
+
+    using Shard = LockedShard<std::shared_mutex, Table>;
+
+    size_t shard_bits_;
+    std::unique_ptr<Shard[]> shards_;
+
+    Shard& ShardFor(uint64_t hash);
+    static const InternedEntry* Find(const Table& table, uint64_t hash, const char* str, size_t size);
+    static void Insert(Table& table, const InternedEntry* entry);
+};
+
+#endif //STRING_STRINGPOOL_HPP
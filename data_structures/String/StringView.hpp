@@ -0,0 +1,184 @@
+#ifndef STRING_STRINGVIEW_HPP
+#define STRING_STRINGVIEW_HPP
+
+#include <cstddef>
+#include <iostream>
+
+size_t CStrLen(const char* str);
+
+// Byte-level searches behind String and StringView, vectorized where the
+// target has SSE2 or AVX2. The Find functions return StringView::kNpos
+// when there is no match.
+
+// index of the first byte where the buffers differ, size if there is none
+size_t MismatchIndex(const char* first, const char* second, size_t size);
+size_t FindByte(const char* data, size_t size, char symbol);
+size_t FindLastByte(const char* data, size_t size, char symbol);
+size_t FindBytes(const char* data, size_t size, const char* pattern, size_t pattern_size);
+size_t FindLastBytes(const char* data, size_t size, const char* pattern, size_t pattern_size);
+
+// Characters owned by someone else: a pointer and a length, so slicing
+// allocates nothing. The characters must outlive the view and need not be
+// null-terminated. Positions past the end are clamped to Size().
+class StringView {
+public:
+    StringView() : data_(""), size_(0) {
+    }
+
+    StringView(const char* str) : data_(str), size_(CStrLen(str)) {
+    }
+
+    StringView(const char* str, size_t size) : data_(str), size_(size) {
+    }
+
+    const char* Data() const {
+        return data_;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t Length() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    char operator[](size_t idx) const {
+        return data_[idx];
+    }
+
+    char Front() const {
+        return data_[0];
+    }
+
+    char Back() const {
+        return data_[size_ - 1];
+    }
+
+    const char* begin() const {
+        return data_;
+    }
+
+    const char* end() const {
+        return data_ + size_;
+    }
+
+    StringView Substr(size_t pos, size_t count = kNpos) const {
+        pos = Clamp(pos, size_);
+        return StringView(data_ + pos, Clamp(count, size_ - pos));
+    }
+
+    void RemovePrefix(size_t count) {
+        count = Clamp(count, size_);
+        data_ += count;
+        size_ -= count;
+    }
+
+    void RemoveSuffix(size_t count) {
+        size_ -= Clamp(count, size_);
+    }
+
+    // position of the first occurrence at or after pos, kNpos if there is none
+    size_t Find(char symbol, size_t pos = 0) const {
+        if (pos >= size_) {
+            return kNpos;
+        }
+        const size_t found = FindByte(data_ + pos, size_ - pos, symbol);
+        return found == kNpos ? kNpos : pos + found;
+    }
+
+    size_t Find(StringView pattern, size_t pos = 0) const {
+        if (pos > size_) {
+            return kNpos;
+        }
+        const size_t found = FindBytes(data_ + pos, size_ - pos, pattern.data_, pattern.size_);
+        return found == kNpos ? kNpos : pos + found;
+    }
+
+    // position of the last occurrence that starts at or before pos
+    size_t RFind(char symbol, size_t pos = kNpos) const {
+        if (size_ == 0) {
+            return kNpos;
+        }
+        return FindLastByte(data_, Clamp(pos, size_ - 1) + 1, symbol);
+    }
+
+    size_t RFind(StringView pattern, size_t pos = kNpos) const {
+        if (pattern.size_ > size_) {
+            return kNpos;
+        }
+        const size_t last_start = Clamp(pos, size_ - pattern.size_);
+        return FindLastBytes(data_, last_start + pattern.size_, pattern.data_, pattern.size_);
+    }
+
+    bool StartsWith(StringView prefix) const {
+        return prefix.size_ <= size_ && MismatchIndex(data_, prefix.data_, prefix.size_) == prefix.size_;
+    }
+
+    bool StartsWith(char symbol) const {
+        return size_ != 0 && data_[0] == symbol;
+    }
+
+    bool EndsWith(StringView suffix) const {
+        return suffix.size_ <= size_
+               && MismatchIndex(data_ + size_ - suffix.size_, suffix.data_, suffix.size_) == suffix.size_;
+    }
+
+    bool EndsWith(char symbol) const {
+        return size_ != 0 && data_[size_ - 1] == symbol;
+    }
+
+    // negative, zero or positive as this view orders before, with or after other
+    int Compare(StringView other) const {
+        const size_t common = Clamp(other.size_, size_);
+        const size_t i = MismatchIndex(data_, other.data_, common);
+        if (i < common) {
+            return static_cast<int>(data_[i]) - static_cast<int>(other.data_[i]);
+        }
+        return size_ < other.size_ ? -1 : (size_ > other.size_ ? 1 : 0);
+    }
+
+    const static size_t kNpos = static_cast<size_t>(-1);
+
+private:
+    const char* data_;
+    size_t size_;
+
+    static size_t Clamp(size_t value, size_t limit) {
+        return value < limit ? value : limit;
+    }
+};
+
+inline bool operator==(StringView lhs, StringView rhs) {
+    return lhs.Size() == rhs.Size() && MismatchIndex(lhs.Data(), rhs.Data(), lhs.Size()) == lhs.Size();
+}
+
+inline bool operator!=(StringView lhs, StringView rhs) {
+    return !(lhs == rhs);
+}
+
+inline bool operator<(StringView lhs, StringView rhs) {
+    return lhs.Compare(rhs) < 0;
+}
+
+inline bool operator>(StringView lhs, StringView rhs) {
+    return lhs.Compare(rhs) > 0;
+}
+
+inline bool operator<=(StringView lhs, StringView rhs) {
+    return !(lhs > rhs);
+}
+
+inline bool operator>=(StringView lhs, StringView rhs) {
+    return !(lhs < rhs);
+}
+
+inline std::ostream& operator<<(std::ostream& os, StringView view) {
+    return os.write(view.Data(), static_cast<std::streamsize>(view.Size()));
+}
+
+#endif //STRING_STRINGVIEW_HPP
@@ -0,0 +1,228 @@
+#ifndef ADDRESSABLEPRIORITYQUEUE_H
+#define ADDRESSABLEPRIORITYQUEUE_H
+
+#include "priorityQueue.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/* PriorityQueue whose elements can be reached again after Push: every
+   element gets a handle that stays valid while it is in the queue, no
+   matter how it moves inside the heap. The heap keeps (value, handle)
+   pairs and a table maps each handle to its current heap index, so
+   DecreaseKey, Update and Erase cost O(log n) instead of a search.
+   Handles of popped or erased elements are reused by later pushes, so
+   using a handle after its element has left the queue is undefined: it
+   may silently reach an element pushed since. */
+template <
+        class T,
+        class Compare = std::less<T>,
+        class Layout = BinaryHeap
+> class AddressablePriorityQueue {
+public:
+    using value_type = T;
+    using value_compare = Compare;
+    using layout_type = Layout;
+    using size_type = size_t;
+    using Handle = size_t;
+
+    /* constructors */
+    AddressablePriorityQueue() = default;
+
+    explicit AddressablePriorityQueue(const Compare& comp) : comp_(comp) {
+    }
+
+    AddressablePriorityQueue(const AddressablePriorityQueue& other) = default;
+
+    AddressablePriorityQueue& operator=(const AddressablePriorityQueue& other) = default;
+
+    AddressablePriorityQueue(AddressablePriorityQueue&& other) noexcept = default;
+
+    AddressablePriorityQueue& operator=(AddressablePriorityQueue&& other) noexcept = default;
+
+    ~AddressablePriorityQueue() = default;
+
+    /* class methods */
+    const T& Top() const {
+        return heap_.front().value_;
+    }
+
+    Handle TopHandle() const {
+        return heap_.front().handle_;
+    }
+
+    size_type Size() const {
+        return heap_.size();
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    bool Contains(const Handle handle) const {
+        return handle < pos_.size() && pos_[handle] != kNone;
+    }
+
+    const T& Get(const Handle handle) const {
+        return heap_[pos_[handle]].value_;
+    }
+
+    Handle Push(const T& item) {
+        return Emplace(item);
+    }
+
+    Handle Push(T&& item) {
+        return Emplace(std::move(item));
+    }
+
+    /* the entry is in place before a handle is taken, so a throwing
+       constructor or allocation leaves the handle table untouched */
+    template <class... Args>
+    Handle Emplace(Args&&... args) {
+        heap_.push_back(Entry{T(std::forward<Args>(args)...), kNone});
+        Handle handle;
+        if (free_handles_.empty()) {
+            try {
+                pos_.push_back(kNone);
+            } catch (...) {
+                heap_.pop_back();
+                throw;
+            }
+            handle = pos_.size() - 1;
+        } else {
+            handle = free_handles_.back();
+            free_handles_.pop_back();
+        }
+
+        heap_.back().handle_ = handle;
+        pos_[handle] = Size() - 1;
+        SiftUp(Size() - 1);
+        return handle;
+    }
+
+    void Pop() {
+        EraseAt(0);
+    }
+
+    void Erase(const Handle handle) {
+        EraseAt(pos_[handle]);
+    }
+
+    /* moves the element towards the top; with std::greater, i.e. a min-heap
+       as in Dijkstra's algorithm, the new value must not be larger */
+    void DecreaseKey(const Handle handle, T value) {
+        const size_t idx = pos_[handle];
+        heap_[idx].value_ = std::move(value);
+        SiftUp(idx);
+    }
+
+    /* sets a new value that may move the element either way */
+    void Update(const Handle handle, T value) {
+        const size_t idx = pos_[handle];
+        const bool up = comp_(heap_[idx].value_, value);
+        heap_[idx].value_ = std::move(value);
+        if (up) {
+            SiftUp(idx);
+        } else {
+            SiftDown(idx);
+        }
+    }
+
+    void Clear() {
+        heap_.clear();
+        pos_.clear();
+        free_handles_.clear();
+    }
+
+    void Swap(AddressablePriorityQueue& other) {
+        std::swap(heap_, other.heap_);
+        std::swap(pos_, other.pos_);
+        std::swap(free_handles_, other.free_handles_);
+        std::swap(comp_, other.comp_);
+    }
+
+private:
+    static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+    struct Entry {
+        T value_;
+        Handle handle_;
+    };
+
+    std::vector<Entry> heap_;
+    /* heap index of every handle, kNone for unused ones */
+    std::vector<size_t> pos_;
+    std::vector<Handle> free_handles_;
+    Compare comp_;
+
+    void EraseAt(const size_t idx) {
+        const Handle handle = heap_[idx].handle_;
+        free_handles_.push_back(handle);
+        pos_[handle] = kNone;
+
+        if (idx + 1 == Size()) {
+            heap_.pop_back();
+            return;
+        }
+
+        heap_[idx] = std::move(heap_.back());
+        heap_.pop_back();
+        pos_[heap_[idx].handle_] = idx;
+        /* the element taken from the back may belong above or below idx */
+        if (idx > 0 && comp_(heap_[Layout::Parent(idx)].value_, heap_[idx].value_)) {
+            SiftUp(idx);
+        } else {
+            SiftDown(idx);
+        }
+    }
+
+    /* the moving entry is held aside and the others are shifted into the
+       hole, so each level costs one move and one table update */
+    void SiftUp(const size_t idx) {
+        size_t i = idx;
+        Entry item = std::move(heap_[i]);
+
+        while (i > 0 && comp_(heap_[Layout::Parent(i)].value_, item.value_)) {
+            const size_t parent = Layout::Parent(i);
+            heap_[i] = std::move(heap_[parent]);
+            pos_[heap_[i].handle_] = i;
+            i = parent;
+        }
+
+        heap_[i] = std::move(item);
+        pos_[heap_[i].handle_] = i;
+    }
+
+    void SiftDown(const size_t idx) {
+        size_t i = idx;
+        Entry item = std::move(heap_[i]);
+
+        while (Layout::FirstChild(i) < Size()) {
+            const size_t first = Layout::FirstChild(i);
+            const size_t last = std::min(first + Layout::kArity, Size());
+
+            size_t largest = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (comp_(heap_[largest].value_, heap_[child].value_)) {
+                    largest = child;
+                }
+            }
+
+            if (!comp_(item.value_, heap_[largest].value_)) {
+                break;
+            }
+            heap_[i] = std::move(heap_[largest]);
+            pos_[heap_[i].handle_] = i;
+            i = largest;
+        }
+
+        heap_[i] = std::move(item);
+        pos_[heap_[i].handle_] = i;
+    }
+};
+
+#endif //ADDRESSABLEPRIORITYQUEUE_H
@@ -0,0 +1,314 @@
+#ifndef ALLOCATORS_H
+#define ALLOCATORS_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Runtime source of raw memory, so that non-template containers
+// like String can be pointed at an arena as well.
+class MemoryResource {
+public:
+    virtual ~MemoryResource() = default;
+
+    virtual void* Allocate(size_t bytes, size_t alignment) = 0;
+    virtual void Deallocate(void* ptr, size_t bytes, size_t alignment) = 0;
+};
+
+class NewDeleteResource : public MemoryResource {
+public:
+    void* Allocate(size_t bytes, size_t alignment) override {
+        if (alignment > alignof(std::max_align_t)) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+        return ::operator new(bytes);
+    }
+
+    void Deallocate(void* ptr, size_t, size_t alignment) override {
+        if (alignment > alignof(std::max_align_t)) {
+            ::operator delete(ptr, std::align_val_t(alignment));
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+};
+
+inline MemoryResource* DefaultResource() {
+    static NewDeleteResource resource;
+    return &resource;
+}
+
+// Bump-pointer arena: Deallocate is a no-op and everything handed out
+// is returned to the upstream resource at once by Release or destruction.
+class Arena : public MemoryResource {
+public:
+    explicit Arena(size_t chunk_size = kDefaultChunkSize, MemoryResource* upstream = DefaultResource())
+            : chunk_size_(chunk_size), upstream_(upstream), chunks_(nullptr), current_(nullptr), end_(nullptr) {
+    }
+
+    Arena(const Arena& other) = delete;
+
+    Arena& operator=(const Arena& other) = delete;
+
+    ~Arena() override {
+        Release();
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) override {
+        std::uintptr_t aligned = AlignUp(reinterpret_cast<std::uintptr_t>(current_), alignment);
+        if (current_ == nullptr || aligned + bytes > reinterpret_cast<std::uintptr_t>(end_)) {
+            NewChunk(bytes + alignment);
+            aligned = AlignUp(reinterpret_cast<std::uintptr_t>(current_), alignment);
+        }
+        current_ = reinterpret_cast<char*>(aligned + bytes);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void Deallocate(void*, size_t, size_t) override {
+    }
+
+    void Release() {
+        while (chunks_ != nullptr) {
+            ChunkHeader* next = chunks_->next_;
+            upstream_->Deallocate(chunks_, chunks_->size_, alignof(std::max_align_t));
+            chunks_ = next;
+        }
+        current_ = nullptr;
+        end_ = nullptr;
+    }
+
+private:
+    struct alignas(std::max_align_t) ChunkHeader {
+        ChunkHeader* next_;
+        size_t size_;
+    };
+
+    static const size_t kDefaultChunkSize = 64 * 1024;
+
+    size_t chunk_size_;
+    MemoryResource* upstream_;
+    ChunkHeader* chunks_;
+    char* current_;
+    char* end_;
+
+    static std::uintptr_t AlignUp(std::uintptr_t address, size_t alignment) {
+        return (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    }
+
+    void NewChunk(size_t min_bytes) {
+        size_t size = sizeof(ChunkHeader) + (min_bytes > chunk_size_ ? min_bytes : chunk_size_);
+        void* memory = upstream_->Allocate(size, alignof(std::max_align_t));
+        chunks_ = new (memory) ChunkHeader{chunks_, size};
+        current_ = reinterpret_cast<char*>(chunks_ + 1);
+        end_ = reinterpret_cast<char*>(chunks_) + size;
+    }
+};
+
+// Per-thread segregated free lists. Small blocks are carved out of slabs
+// that live until the thread exits, so memory from this pool must be freed
+// on the thread that allocated it and must not outlive that thread.
+class ThreadLocalPool {
+public:
+    static const size_t kGranularity = 16;
+    static const size_t kMaxBlockSize = 256;
+
+    ThreadLocalPool() : slabs_(nullptr), free_lists_() {
+    }
+
+    ThreadLocalPool(const ThreadLocalPool& other) = delete;
+
+    ThreadLocalPool& operator=(const ThreadLocalPool& other) = delete;
+
+    ~ThreadLocalPool() {
+        while (slabs_ != nullptr) {
+            FreeBlock* next = slabs_->next_;
+            ::operator delete(slabs_);
+            slabs_ = next;
+        }
+    }
+
+    static ThreadLocalPool& Instance() {
+        thread_local ThreadLocalPool pool;
+        return pool;
+    }
+
+    static bool Serves(size_t bytes, size_t alignment) {
+        return bytes <= kMaxBlockSize && alignment <= alignof(std::max_align_t);
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) {
+        if (!Serves(bytes, alignment)) {
+            return DefaultResource()->Allocate(bytes, alignment);
+        }
+        const size_t cls = SizeClass(bytes);
+        if (free_lists_[cls] == nullptr) {
+            Refill(cls);
+        }
+        FreeBlock* block = free_lists_[cls];
+        free_lists_[cls] = block->next_;
+        return block;
+    }
+
+    void Deallocate(void* ptr, size_t bytes, size_t alignment) {
+        if (!Serves(bytes, alignment)) {
+            DefaultResource()->Deallocate(ptr, bytes, alignment);
+            return;
+        }
+        const size_t cls = SizeClass(bytes);
+        free_lists_[cls] = new (ptr) FreeBlock{free_lists_[cls]};
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next_;
+    };
+
+    static const size_t kSlabSize = 64 * 1024;
+    static const size_t kClasses = kMaxBlockSize / kGranularity;
+
+    FreeBlock* slabs_;
+    FreeBlock* free_lists_[kClasses];
+
+    static size_t SizeClass(size_t bytes) {
+        return bytes == 0 ? 0 : (bytes - 1) / kGranularity;
+    }
+
+    void Refill(size_t cls) {
+        const size_t block_size = (cls + 1) * kGranularity;
+        char* slab = static_cast<char*>(::operator new(kSlabSize));
+        // the first block of every slab links the slabs for the destructor
+        slabs_ = new (slab) FreeBlock{slabs_};
+        const size_t header = alignof(std::max_align_t);
+        for (size_t i = (kSlabSize - header) / block_size; i > 0; --i) {
+            free_lists_[cls] = new (slab + header + (i - 1) * block_size) FreeBlock{free_lists_[cls]};
+        }
+    }
+};
+
+// Bound to the pool of the thread that created it. Memory has to go back
+// through the resource it came from, and the checks below catch a container
+// that was handed to another thread together with its pooled memory.
+class ThreadLocalPoolResource : public MemoryResource {
+public:
+    ThreadLocalPoolResource() : pool_(&ThreadLocalPool::Instance()) {
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) override {
+        assert(pool_ == &ThreadLocalPool::Instance() && "pooled memory used off its thread");
+        return pool_->Allocate(bytes, alignment);
+    }
+
+    void Deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        assert(pool_ == &ThreadLocalPool::Instance() && "pooled memory freed off its thread");
+        pool_->Deallocate(ptr, bytes, alignment);
+    }
+
+private:
+    ThreadLocalPool* pool_;
+};
+
+// the calling thread's resource
+inline MemoryResource* PoolResource() {
+    thread_local ThreadLocalPoolResource resource;
+    return &resource;
+}
+
+// std::allocator_traits compatible allocator over a MemoryResource.
+template <class T>
+class ResourceAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ResourceAllocator() noexcept : resource_(DefaultResource()) {
+    }
+
+    ResourceAllocator(MemoryResource* resource) noexcept : resource_(resource) {
+    }
+
+    template <class U>
+    ResourceAllocator(const ResourceAllocator<U>& other) noexcept : resource_(other.Resource()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(resource_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        resource_->Deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    MemoryResource* Resource() const noexcept {
+        return resource_;
+    }
+
+private:
+    MemoryResource* resource_;
+};
+
+template <class T, class U>
+bool operator==(const ResourceAllocator<T>& lhs, const ResourceAllocator<U>& rhs) {
+    return lhs.Resource() == rhs.Resource();
+}
+
+template <class T, class U>
+bool operator!=(const ResourceAllocator<T>& lhs, const ResourceAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T>
+using ArenaAllocator = ResourceAllocator<T>;
+
+// Allocator over the ThreadLocalPool of the thread that created it. Copies
+// share that pool and compare equal; allocators from different threads do
+// not, so containers never mix their memory. The pool's free lists are not
+// synchronized, so a container holding one may only allocate and free on
+// the owning thread, and must be gone before that thread exits.
+template <class T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PoolAllocator() noexcept : pool_(&ThreadLocalPool::Instance()) {
+    }
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.Pool()) {
+    }
+
+    T* allocate(size_t n) {
+        assert(pool_ == &ThreadLocalPool::Instance() && "PoolAllocator used off its thread");
+        return static_cast<T*>(pool_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        assert(pool_ == &ThreadLocalPool::Instance() && "PoolAllocator memory freed off its thread");
+        pool_->Deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    ThreadLocalPool* Pool() const noexcept {
+        return pool_;
+    }
+
+private:
+    ThreadLocalPool* pool_;
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return lhs.Pool() == rhs.Pool();
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+#endif //ALLOCATORS_H
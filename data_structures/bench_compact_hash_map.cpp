@@ -0,0 +1,83 @@
+#include "compactStringMap.h"
+#include "hashTable.h"
+#include "timeProfiler.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// bytes currently allocated through operator new
+static size_t live_bytes = 0;
+
+void* operator new(size_t size) {
+    // the size is kept in front of the block so that delete can subtract it
+    auto* block = static_cast<size_t*>(std::malloc(size + alignof(std::max_align_t)));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *block = size;
+    live_bytes += size;
+    return reinterpret_cast<char*>(block) + alignof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        auto* block = reinterpret_cast<size_t*>(static_cast<char*>(ptr) - alignof(std::max_align_t));
+        live_bytes -= *block;
+        std::free(block);
+    }
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+std::vector<std::string> RandomKeys(const size_t count, std::mt19937& generator) {
+    std::uniform_int_distribution<> length(8, 32);
+    std::uniform_int_distribution<> letter('a', 'z');
+    std::vector<std::string> keys(count);
+    for (auto& key : keys) {
+        key.resize(length(generator));
+        for (auto& c : key) {
+            c = static_cast<char>(letter(generator));
+        }
+    }
+    return keys;
+}
+
+template <class Map>
+void Run(const char* info, const std::vector<std::string>& keys, const std::vector<std::string>& misses) {
+    const size_t before = live_bytes;
+    Map map;
+    for (const auto& key : keys) {
+        map.Add(key);
+    }
+    std::cout << info << " memory: " << (live_bytes - before) / (1 << 20) << " MiB\n";
+
+    size_t found = 0;
+    {
+        TimeProfiler profiler("    search hit + miss");
+        for (size_t i = 0; i < keys.size(); ++i) {
+            found += map.Contains(keys[i]);
+            found += map.Contains(misses[i]);
+        }
+    }
+    std::cout << "    found: " << found << '\n';
+}
+
+int main() {
+    const size_t N = 2'000'000;
+
+    std::mt19937 generator(42);
+    const std::vector<std::string> keys = RandomKeys(N, generator);
+    const std::vector<std::string> misses = RandomKeys(N, generator);
+
+    Run<HashMap<std::string, bool>>("HashMap<std::string, bool>", keys, misses);
+    Run<CompactStringMap<bool>>("CompactStringMap<bool>", keys, misses);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "concurrentHashMap.h"
+#include "hashTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// the setup we are replacing: one HashMap behind one global mutex
+class GlobalLockMap {
+public:
+    bool Add(uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return map_.Add(key);
+    }
+
+    bool Contains(uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return map_.Contains(key);
+    }
+
+    bool Delete(uint64_t key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return map_.Delete(key);
+    }
+
+private:
+    std::mutex mutex_;
+    HashMap<uint64_t, uint64_t> map_;
+};
+
+// million operations per second over all threads
+template <class Map>
+double Throughput(Map& map, const size_t threads, const int read_percent, const size_t ops_per_thread) {
+    const uint64_t kKeyRange = 1 << 20;
+    std::atomic<size_t> hits{0};
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&map, &hits, t, read_percent, ops_per_thread, kKeyRange]() {
+            std::mt19937_64 generator(t + 1);
+            size_t local_hits = 0;
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                const uint64_t key = generator() % kKeyRange;
+                const int dice = static_cast<int>(generator() % 100);
+                if (dice < read_percent) {
+                    local_hits += map.Contains(key);
+                } else if (dice % 2 == 0) {
+                    local_hits += map.Add(key);
+                } else {
+                    local_hits += map.Delete(key);
+                }
+            }
+            hits += local_hits;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> spent = std::chrono::steady_clock::now() - start;
+
+    return static_cast<double>(threads * ops_per_thread) / spent.count() / 1e6;
+}
+
+int main() {
+    const size_t kOpsPerThread = 1'000'000;
+    const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+    for (const int read_percent : {50, 90, 99}) {
+        std::cout << "reads " << read_percent << "%\n";
+        for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+            GlobalLockMap global;
+            ConcurrentHashMap<uint64_t, uint64_t> sharded;
+            std::cout << "  threads " << threads
+                      << ": global lock " << Throughput(global, threads, read_percent, kOpsPerThread)
+                      << " Mops/s, sharded " << Throughput(sharded, threads, read_percent, kOpsPerThread)
+                      << " Mops/s\n";
+        }
+    }
+
+    return 0;
+}
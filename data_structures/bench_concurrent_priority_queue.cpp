@@ -0,0 +1,160 @@
+#include "concurrentPriorityQueue.h"
+#include "priorityQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// the setup we are replacing: one PriorityQueue behind one global mutex
+class GlobalLockQueue {
+public:
+    void Push(uint64_t item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.Push(item);
+    }
+
+    std::optional<uint64_t> Pop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.Empty()) {
+            return std::nullopt;
+        }
+        const uint64_t item = queue_.Top();
+        queue_.Pop();
+        return item;
+    }
+
+private:
+    std::mutex mutex_;
+    PriorityQueue<uint64_t> queue_;
+};
+
+// million operations per second over all threads, half pushes and half pops
+template <class Queue>
+double Throughput(Queue& queue, const size_t threads, const size_t ops_per_thread) {
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&queue, t, ops_per_thread]() {
+            std::mt19937_64 generator(t + 1);
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                if (generator() % 2 == 0) {
+                    queue.Push(generator());
+                } else {
+                    queue.Pop();
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> spent = std::chrono::steady_clock::now() - start;
+
+    return static_cast<double>(threads * ops_per_thread) / spent.count() / 1e6;
+}
+
+// Fenwick tree over the keys 0..size-1 that are still in the queue
+class PresentKeys {
+public:
+    explicit PresentKeys(size_t size) : tree_(size + 1, 0) {
+        for (size_t i = 0; i < size; ++i) {
+            Add(i, 1);
+        }
+    }
+
+    void Add(size_t key, int delta) {
+        for (size_t i = key + 1; i < tree_.size(); i += i & (~i + 1)) {
+            tree_[i] += delta;
+        }
+    }
+
+    // present keys below key
+    int64_t Below(size_t key) const {
+        int64_t count = 0;
+        for (size_t i = key; i > 0; i -= i & (~i + 1)) {
+            count += tree_[i];
+        }
+        return count;
+    }
+
+private:
+    std::vector<int64_t> tree_;
+};
+
+// Keys 0..count-1 are popped by all threads at once. Pops are put in order
+// by a ticket taken right after each of them, and the rank error of a pop
+// is the number of larger keys that were still in the queue at that point.
+template <class Queue>
+double MeanRankError(Queue& queue, const size_t threads, const size_t count) {
+    std::mt19937_64 generator(7);
+    std::vector<uint64_t> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), generator);
+    for (const uint64_t key : keys) {
+        queue.Push(key);
+    }
+
+    std::atomic<size_t> ticket{0};
+    std::vector<uint64_t> order(count);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&queue, &ticket, &order]() {
+            while (std::optional<uint64_t> key = queue.Pop()) {
+                order[ticket.fetch_add(1)] = *key;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    PresentKeys present(count);
+    double total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t key = static_cast<size_t>(order[i]);
+        total += static_cast<double>(static_cast<int64_t>(count - i) - 1 - present.Below(key));
+        present.Add(key, -1);
+    }
+    return total / static_cast<double>(count);
+}
+
+int main() {
+    const size_t kOpsPerThread = 1'000'000;
+    const size_t kRankKeys = 1'000'000;
+    const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+    std::cout << "throughput\n";
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        GlobalLockQueue global;
+        ConcurrentPriorityQueue<uint64_t> relaxed(4 * threads, 2);
+        ConcurrentPriorityQueue<uint64_t> stricter(4 * threads, 4);
+        std::cout << "  threads " << threads
+                  << ": global lock " << Throughput(global, threads, kOpsPerThread)
+                  << " Mops/s, multiqueue c=2 " << Throughput(relaxed, threads, kOpsPerThread)
+                  << " Mops/s, c=4 " << Throughput(stricter, threads, kOpsPerThread) << " Mops/s\n";
+    }
+
+    std::cout << "mean rank error\n";
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        GlobalLockQueue global;
+        ConcurrentPriorityQueue<uint64_t> relaxed(4 * threads, 2);
+        ConcurrentPriorityQueue<uint64_t> stricter(4 * threads, 4);
+        std::cout << "  threads " << threads
+                  << ": global lock " << MeanRankError(global, threads, kRankKeys)
+                  << ", multiqueue c=2 " << MeanRankError(relaxed, threads, kRankKeys)
+                  << ", c=4 " << MeanRankError(stricter, threads, kRankKeys) << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "flatHashMap.h"
+#include "hashTable.h"
+#include "timeProfiler.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+std::vector<std::string> RandomKeys(const size_t count, std::mt19937& generator) {
+    std::uniform_int_distribution<> length(8, 24);
+    std::uniform_int_distribution<> letter('a', 'z');
+    std::vector<std::string> keys(count);
+    for (auto& key : keys) {
+        key.resize(length(generator));
+        for (auto& c : key) {
+            c = static_cast<char>(letter(generator));
+        }
+    }
+    return keys;
+}
+
+// slowest single Add while the map keeps growing, i.e. the cost of a rehash
+double WorstAddMicroseconds(HashMap<std::string, int>& map, const std::vector<std::string>& keys) {
+    double worst = 0;
+    for (const auto& key : keys) {
+        auto start = std::chrono::steady_clock::now();
+        map.Add(key);
+        std::chrono::duration<double, std::micro> spent = std::chrono::steady_clock::now() - start;
+        if (spent.count() > worst) {
+            worst = spent.count();
+        }
+    }
+    return worst;
+}
+
+int main() {
+    const size_t N = 500'000;
+
+    std::mt19937 generator(42);
+    const std::vector<std::string> keys = RandomKeys(N, generator);
+    const std::vector<std::string> misses = RandomKeys(N, generator);
+
+    size_t found = 0;
+
+    {
+        HashMap<std::string, int> map;
+        {
+            TimeProfiler profiler("HashMap add");
+            for (const auto& key : keys) {
+                map.Add(key);
+            }
+        }
+        {
+            TimeProfiler profiler("HashMap search hit + miss");
+            for (size_t i = 0; i < N; ++i) {
+                found += map.Search(keys[i]) != nullptr;
+                found += map.Search(misses[i]) != nullptr;
+            }
+        }
+        {
+            TimeProfiler profiler("HashMap delete");
+            for (const auto& key : keys) {
+                found += map.Delete(key);
+            }
+        }
+    }
+
+    {
+        FlatHashMap<std::string, int> map;
+        {
+            TimeProfiler profiler("FlatHashMap add");
+            for (const auto& key : keys) {
+                map.Add(key);
+            }
+        }
+        {
+            TimeProfiler profiler("FlatHashMap search hit + miss");
+            for (size_t i = 0; i < N; ++i) {
+                found += map.Search(keys[i]) != nullptr;
+                found += map.Search(misses[i]) != nullptr;
+            }
+        }
+        {
+            TimeProfiler profiler("FlatHashMap delete");
+            for (const auto& key : keys) {
+                found += map.Delete(key);
+            }
+        }
+    }
+
+    {
+        std::unordered_set<std::string> set;
+        {
+            TimeProfiler profiler("std::unordered_set insert");
+            for (const auto& key : keys) {
+                set.insert(key);
+            }
+        }
+        {
+            TimeProfiler profiler("std::unordered_set find hit + miss");
+            for (size_t i = 0; i < N; ++i) {
+                found += set.count(keys[i]);
+                found += set.count(misses[i]);
+            }
+        }
+        {
+            TimeProfiler profiler("std::unordered_set erase");
+            for (const auto& key : keys) {
+                found += set.erase(key);
+            }
+        }
+    }
+
+    {
+        HashMap<std::string, int> stop_the_world(false);
+        HashMap<std::string, int> incremental(true);
+        std::cout << "HashMap worst add, full rehash (us): " << WorstAddMicroseconds(stop_the_world, keys) << '\n';
+        std::cout << "HashMap worst add, incremental rehash (us): " << WorstAddMicroseconds(incremental, keys) << '\n';
+    }
+
+    std::cout << "checksum: " << found << '\n';
+    return 0;
+}
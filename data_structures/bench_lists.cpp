@@ -0,0 +1,91 @@
+#include "forwardList.h"
+#include "list.h"
+#include "timeProfiler.h"
+
+#include <forward_list>
+#include <iostream>
+#include <list>
+
+// build, walk and destroy a singly linked list of count nodes
+template <class ForwardListType>
+void RunForward(const char* info, const int count) {
+    std::cout << info << '\n';
+    long long sum = 0;
+    {
+        TimeProfiler total("    total");
+        ForwardListType list;
+        {
+            TimeProfiler profiler("    push_front");
+            for (int i = 0; i < count; ++i) {
+                list.push_front(i);
+            }
+        }
+        {
+            TimeProfiler profiler("    traverse");
+            for (int value : list) {
+                sum += value;
+            }
+        }
+        {
+            TimeProfiler profiler("    pop half, push half");
+            for (int i = 0; i < count / 2; ++i) {
+                list.pop_front();
+            }
+            for (int i = 0; i < count / 2; ++i) {
+                list.push_front(i);
+            }
+        }
+        TimeProfiler profiler("    destroy");
+        list.clear();
+    }
+    std::cout << "    checksum: " << sum << '\n';
+}
+
+// build, walk, cut up and destroy a doubly linked list of count nodes
+template <class ListType>
+void RunDouble(const char* info, const int count) {
+    std::cout << info << '\n';
+    long long sum = 0;
+    {
+        TimeProfiler total("    total");
+        ListType list;
+        {
+            TimeProfiler profiler("    push_back");
+            for (int i = 0; i < count; ++i) {
+                list.push_back(i);
+            }
+        }
+        {
+            TimeProfiler profiler("    traverse");
+            for (int value : list) {
+                sum += value;
+            }
+        }
+        {
+            TimeProfiler profiler("    erase every other, splice halves");
+            for (auto it = list.begin(); it != list.end();) {
+                it = list.erase(it);
+                if (it != list.end()) {
+                    ++it;
+                }
+            }
+            ListType other;
+            other.splice(other.end(), list);
+            list.splice(list.begin(), other);
+        }
+        TimeProfiler profiler("    destroy");
+        list.clear();
+    }
+    std::cout << "    checksum: " << sum << '\n';
+}
+
+int main() {
+    const int N = 10'000'000;
+
+    RunForward<ForwardList<int>>("ForwardList<int>", N);
+    RunForward<std::forward_list<int>>("std::forward_list<int>", N);
+    RunDouble<List<int>>("List<int>", N);
+    RunDouble<std::list<int>>("std::list<int>", N);
+
+    return 0;
+}
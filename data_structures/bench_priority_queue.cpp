@@ -0,0 +1,104 @@
+#include "addressablePriorityQueue.h"
+#include "priorityQueue.h"
+#include "timeProfiler.h"
+
+#include <algorithm>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+
+// N pushes followed by N pops
+template <class Queue>
+long long FillAndDrain(const std::vector<int>& values) {
+    Queue queue;
+    for (int value : values) {
+        queue.Push(value);
+    }
+    long long sum = 0;
+    while (!queue.Empty()) {
+        sum += queue.Top();
+        queue.Pop();
+    }
+    return sum;
+}
+
+// the queue holds N elements while each step pops the top and pushes a new one
+template <class Queue>
+long long Hold(const std::vector<int>& values, size_t steps) {
+    Queue queue;
+    for (int value : values) {
+        queue.Push(value);
+    }
+    long long sum = 0;
+    for (size_t i = 0; i < steps; ++i) {
+        const int top = queue.Top();
+        sum += top;
+        queue.Pop();
+        queue.Push(top - values[i % values.size()] % 1024);
+    }
+    return sum;
+}
+
+// batches of 4096 values pushed one by one or with PushRange
+template <class Queue>
+void Batches(const char* info, const std::vector<int>& values, bool use_range) {
+    const size_t kBatch = 4096;
+    Queue queue;
+    TimeProfiler profiler(info);
+    for (size_t i = 0; i < values.size(); i += kBatch) {
+        const auto first = values.begin() + i;
+        const auto last = values.begin() + std::min(i + kBatch, values.size());
+        if (use_range) {
+            queue.PushRange(first, last);
+        } else {
+            for (auto it = first; it != last; ++it) {
+                queue.Push(*it);
+            }
+        }
+    }
+}
+
+template <class Queue>
+void Run(const char* info, const std::vector<int>& values) {
+    std::cout << info << '\n';
+    long long sum = 0;
+    {
+        TimeProfiler profiler("    push all, pop all");
+        sum += FillAndDrain<Queue>(values);
+    }
+    {
+        TimeProfiler profiler("    hold (pop + push)");
+        sum += Hold<Queue>(values, 4 * values.size());
+    }
+    std::cout << "    checksum: " << sum << '\n';
+}
+
+int main() {
+    const size_t N = 2'000'000;
+
+    std::mt19937 generator(42);
+    std::vector<int> values(N);
+    for (auto& value : values) {
+        value = static_cast<int>(generator() >> 1);
+    }
+
+    using Binary = PriorityQueue<int, std::vector<int>, std::less<int>, BinaryHeap>;
+    using Quaternary = PriorityQueue<int, std::vector<int>, std::less<int>, QuaternaryHeap>;
+    using Octonary = PriorityQueue<int, std::vector<int>, std::less<int>, DaryHeap<8>>;
+
+    Run<Binary>("PriorityQueue, binary", values);
+    Run<Quaternary>("PriorityQueue, 4-ary", values);
+    Run<Octonary>("PriorityQueue, 8-ary", values);
+    Run<AddressablePriorityQueue<int, std::less<int>, BinaryHeap>>("AddressablePriorityQueue, binary", values);
+    Run<AddressablePriorityQueue<int, std::less<int>, QuaternaryHeap>>("AddressablePriorityQueue, 4-ary", values);
+
+    std::vector<int> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    Batches<Binary>("Push in batches, random", values, false);
+    Batches<Binary>("PushRange in batches, random", values, true);
+    Batches<Binary>("Push in batches, ascending", sorted, false);
+    Batches<Binary>("PushRange in batches, ascending", sorted, true);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "Stack_Queue/Queue.h"
+#include "Stack_Queue/RingQueue.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// the setup we are replacing: a Queue behind a mutex
+class LockedQueue {
+public:
+    explicit LockedQueue(size_t) {
+    }
+
+    void Push(int64_t value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.Push(value);
+    }
+
+    int64_t Pop() {
+        for (;;) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!queue_.Empty()) {
+                    const int64_t value = queue_.Front();
+                    queue_.Pop();
+                    return value;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    BasicQueue<int64_t> queue_;
+};
+
+// million values per second moved from producers to consumers
+template <class QueueType>
+double Throughput(const size_t producers, const size_t consumers, const int64_t per_producer) {
+    QueueType queue(1024);
+    std::vector<std::thread> workers;
+    const int64_t per_consumer = per_producer * static_cast<int64_t>(producers) / static_cast<int64_t>(consumers);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < producers; ++p) {
+        workers.emplace_back([&queue, per_producer]() {
+            for (int64_t i = 0; i < per_producer; ++i) {
+                queue.Push(i);
+            }
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        workers.emplace_back([&queue, per_consumer]() {
+            int64_t sum = 0;
+            for (int64_t i = 0; i < per_consumer; ++i) {
+                sum += queue.Pop();
+            }
+            if (sum < 0) {
+                std::cout << sum;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> spent = std::chrono::steady_clock::now() - start;
+
+    return static_cast<double>(per_producer * static_cast<int64_t>(producers)) / spent.count() / 1e6;
+}
+
+// mean one-way latency in nanoseconds: a value is passed to another
+// thread and back through two queues, and the round trip is halved
+template <class QueueType>
+double Latency(const int64_t round_trips) {
+    QueueType ping(1024);
+    QueueType pong(1024);
+
+    std::thread echo([&ping, &pong, round_trips]() {
+        for (int64_t i = 0; i < round_trips; ++i) {
+            pong.Push(ping.Pop());
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < round_trips; ++i) {
+        ping.Push(i);
+        pong.Pop();
+    }
+    std::chrono::duration<double, std::nano> spent = std::chrono::steady_clock::now() - start;
+    echo.join();
+
+    return spent.count() / static_cast<double>(round_trips) / 2;
+}
+
+int main() {
+    const int64_t kValues = 5'000'000;
+    const int64_t kRoundTrips = 100'000;
+
+    std::cout << "1 producer, 1 consumer, Mvalues/s\n"
+              << "  locked Queue " << Throughput<LockedQueue>(1, 1, kValues) << '\n'
+              << "  SpscQueue " << Throughput<SpscQueue<int64_t>>(1, 1, kValues) << '\n'
+              << "  MpmcQueue " << Throughput<MpmcQueue<int64_t>>(1, 1, kValues) << '\n';
+
+    std::cout << "2 producers, 2 consumers, Mvalues/s\n"
+              << "  locked Queue " << Throughput<LockedQueue>(2, 2, kValues / 2) << '\n'
+              << "  MpmcQueue " << Throughput<MpmcQueue<int64_t>>(2, 2, kValues / 2) << '\n';
+
+    std::cout << "one-way latency, ns\n"
+              << "  locked Queue " << Latency<LockedQueue>(kRoundTrips) << '\n'
+              << "  SpscQueue " << Latency<SpscQueue<int64_t>>(kRoundTrips) << '\n'
+              << "  MpmcQueue " << Latency<MpmcQueue<int64_t>>(kRoundTrips) << '\n';
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "String/Rope.hpp"
+#include "String/String.hpp"
+#include "timeProfiler.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+int main() {
+    const int kAppends = 2'000'000;
+    const int kInserts = 50'000;
+    const int kSubstrs = 2'000;
+    const char* kPiece = "lorem ipsum dolor ";
+    const size_t kPieceSize = CStrLen(kPiece);
+    uint64_t checksum = 0;
+
+    std::cout << "append " << kAppends << " pieces\n";
+    {
+        TimeProfiler profiler("    String");
+        String text;
+        for (int i = 0; i < kAppends; ++i) {
+            text += kPiece;
+        }
+        checksum += text.Size();
+    }
+    {
+        TimeProfiler profiler("    Rope");
+        Rope text;
+        for (int i = 0; i < kAppends; ++i) {
+            text += kPiece;
+        }
+        checksum += text.Size();
+    }
+
+    std::cout << "insert " << kInserts << " pieces at random positions\n";
+    {
+        TimeProfiler profiler("    std::string");
+        std::mt19937 rng(1);
+        std::string text;
+        for (int i = 0; i < kInserts; ++i) {
+            text.insert(rng() % (text.size() + 1), kPiece);
+        }
+        checksum += text.size();
+    }
+    {
+        TimeProfiler profiler("    Rope");
+        std::mt19937 rng(1);
+        const Rope piece(kPiece);
+        Rope text;
+        for (int i = 0; i < kInserts; ++i) {
+            text.Insert(rng() % (text.Size() + 1), piece);
+        }
+        checksum += text.Size();
+    }
+
+    std::string std_text;
+    Rope text;
+    for (int i = 0; i < kAppends; ++i) {
+        std_text += kPiece;
+        text += kPiece;
+    }
+    const size_t size = text.Size();
+
+    std::cout << "take " << kSubstrs << " substrings of a " << size << "-character text\n";
+    {
+        TimeProfiler profiler("    std::string");
+        std::mt19937 rng(2);
+        for (int i = 0; i < kSubstrs; ++i) {
+            const size_t pos = rng() % size;
+            checksum += std_text.substr(pos, rng() % (size - pos)).size();
+        }
+    }
+    {
+        TimeProfiler profiler("    Rope");
+        std::mt19937 rng(2);
+        for (int i = 0; i < kSubstrs; ++i) {
+            const size_t pos = rng() % size;
+            checksum += text.Substr(pos, rng() % (size - pos)).Size();
+        }
+    }
+
+    std::cout << "flatten\n";
+    {
+        TimeProfiler profiler("    Rope::ToString");
+        checksum += text.ToString().Size();
+    }
+    checksum += kPieceSize;
+    std::cout << "checksum: " << checksum << '\n';
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "smallVector.h"
+#include "timeProfiler.h"
+#include "vector.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+template <class Container>
+long long FillShortLived(const size_t rounds, const size_t length) {
+    long long checksum = 0;
+    for (size_t i = 0; i < rounds; ++i) {
+        Container cnt;
+        for (size_t j = 0; j < length; ++j) {
+            cnt.PushBack(static_cast<int>(i + j));
+        }
+        checksum += cnt.Back();
+    }
+    return checksum;
+}
+
+template <class Container>
+void Run(const char* info, const size_t rounds, const size_t length) {
+    allocations = 0;
+    long long checksum = 0;
+    {
+        TimeProfiler profiler(info);
+        checksum = FillShortLived<Container>(rounds, length);
+    }
+    std::cout << "    allocations: " << allocations << ", checksum: " << checksum << '\n';
+}
+
+int main() {
+    const size_t kRounds = 4'000'000;
+
+    for (const size_t length : {3, 8, 20}) {
+        std::cout << "length " << length << '\n';
+        Run<Vector<int>>("Vector<int>", kRounds, length);
+        Run<SmallVector<int, 8>>("SmallVector<int, 8>", kRounds, length);
+    }
+
+    return 0;
+}
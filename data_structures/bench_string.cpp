@@ -0,0 +1,170 @@
+#include "String/String.hpp"
+#include "timeProfiler.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+// the byte-at-a-time loops String used before its searches were vectorized
+
+size_t ScalarFind(const char* data, size_t size, char symbol) {
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] == symbol) {
+            return i;
+        }
+    }
+    return String::kNpos;
+}
+
+size_t ScalarFind(const char* data, size_t size, const char* pattern, size_t pattern_size) {
+    for (size_t i = 0; i + pattern_size <= size; ++i) {
+        size_t j = 0;
+        while (j < pattern_size && data[i + j] == pattern[j]) {
+            ++j;
+        }
+        if (j == pattern_size) {
+            return i;
+        }
+    }
+    return String::kNpos;
+}
+
+size_t ScalarMismatch(const char* first, const char* second, size_t size) {
+    size_t i = 0;
+    while (i < size && first[i] == second[i]) {
+        ++i;
+    }
+    return i;
+}
+
+// calls on_token(token) for every run of non-blank characters
+template <class Token, class F>
+void ForEachToken(const String& text, F&& on_token) {
+    const char* data = text.Data();
+    const size_t size = text.Size();
+    size_t start = 0;
+    for (size_t i = 0; i <= size; ++i) {
+        if (i == size || data[i] == ' ' || data[i] == '\n') {
+            if (i > start) {
+                on_token(Token(data + start, i - start));
+            }
+            start = i + 1;
+        }
+    }
+}
+
+// log-like text: lines of lowercase words, with the searched bytes absent
+String MakeText(size_t size) {
+    std::mt19937 rng(42);
+    String text;
+    text.Reserve(size);
+    while (text.Size() < size) {
+        const size_t word = 2 + rng() % 9;
+        for (size_t i = 0; i < word; ++i) {
+            text.PushBack(static_cast<char>('a' + rng() % 20));
+        }
+        text.PushBack(rng() % 12 == 0 ? '\n' : ' ');
+    }
+    return text;
+}
+
+int main() {
+    const size_t kSize = 64 << 20;
+    const int kRounds = 20;
+
+    const String text = MakeText(kSize);
+    const std::string std_text(text.CStr(), text.Size());
+    String copy(text);
+    copy[copy.Size() - 1] = '#';
+    const String pattern("error: disk");
+    uint64_t checksum = 0;
+
+    std::cout << text.Size() << " bytes, " << kRounds << " rounds\n";
+    std::cout << "compare with a late mismatch\n";
+    {
+        TimeProfiler profiler("    scalar");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += ScalarMismatch(text.Data(), copy.Data(), text.Size());
+        }
+    }
+    {
+        TimeProfiler profiler("    operator<");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += text < copy;
+        }
+    }
+
+    std::cout << "find a missing char\n";
+    {
+        TimeProfiler profiler("    scalar");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += ScalarFind(text.Data(), text.Size(), '#');
+        }
+    }
+    {
+        TimeProfiler profiler("    std::string::find");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += std_text.find('#');
+        }
+    }
+    {
+        TimeProfiler profiler("    String::Find");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += text.Find('#');
+        }
+    }
+    {
+        TimeProfiler profiler("    String::RFind");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += text.RFind('#');
+        }
+    }
+
+    std::cout << "find a missing word\n";
+    {
+        TimeProfiler profiler("    scalar");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += ScalarFind(text.Data(), text.Size(), pattern.Data(), pattern.Size());
+        }
+    }
+    {
+        TimeProfiler profiler("    std::string::find");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += std_text.find(pattern.CStr());
+        }
+    }
+    {
+        TimeProfiler profiler("    String::Find");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += text.Find(pattern);
+        }
+    }
+    {
+        TimeProfiler profiler("    String::RFind");
+        for (int round = 0; round < kRounds; ++round) {
+            checksum += text.RFind(pattern);
+        }
+    }
+
+    std::cout << "tokenize, " << kRounds / 4 << " rounds\n";
+    {
+        TimeProfiler profiler("    String tokens");
+        for (int round = 0; round < kRounds / 4; ++round) {
+            ForEachToken<String>(text, [&checksum](const String& token) {
+                checksum += token.Size();
+            });
+        }
+    }
+    {
+        TimeProfiler profiler("    StringView tokens");
+        for (int round = 0; round < kRounds / 4; ++round) {
+            ForEachToken<StringView>(text, [&checksum](StringView token) {
+                checksum += token.Size();
+            });
+        }
+    }
+
+    std::cout << "checksum: " << checksum << '\n';
+    return 0;
+}
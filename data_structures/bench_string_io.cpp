@@ -0,0 +1,72 @@
+#include "String/String.hpp"
+#include "timeProfiler.h"
+
+#include <cctype>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+// what operator>> used to do: one stream call and one PushBack per character
+std::istream& ReadByCharacter(std::istream& is, String& str) {
+    str.Clear();
+    int symbol = is.get();
+    while (symbol != EOF && std::isspace(symbol)) {
+        symbol = is.get();
+    }
+    while (symbol != EOF && !std::isspace(symbol)) {
+        str.PushBack(static_cast<char>(symbol));
+        symbol = is.get();
+    }
+    return is;
+}
+
+std::string MakeInput(size_t words, size_t word_size) {
+    std::mt19937 rng(7);
+    std::string input;
+    input.reserve(words * (word_size + 1));
+    for (size_t i = 0; i < words; ++i) {
+        for (size_t j = 0; j < word_size; ++j) {
+            input.push_back(static_cast<char>('a' + rng() % 26));
+        }
+        input.push_back(i % 16 == 15 ? '\n' : ' ');
+    }
+    return input;
+}
+
+void Run(const char* info, const std::string& input) {
+    std::cout << info << '\n';
+    uint64_t checksum = 0;
+    {
+        TimeProfiler profiler("    std::string >>");
+        std::istringstream is(input);
+        std::string word;
+        while (is >> word) {
+            checksum += word.size();
+        }
+    }
+    {
+        TimeProfiler profiler("    by character");
+        std::istringstream is(input);
+        String word;
+        while (ReadByCharacter(is, word), !word.Empty()) {
+            checksum += word.Size();
+        }
+    }
+    {
+        TimeProfiler profiler("    String >>");
+        std::istringstream is(input);
+        String word;
+        while (is >> word) {
+            checksum += word.Size();
+        }
+    }
+    std::cout << "    checksum: " << checksum << '\n';
+}
+
+int main() {
+    Run("20 words of 2,000,000 characters", MakeInput(20, 2'000'000));
+    Run("5,000,000 words of 8 characters", MakeInput(5'000'000, 8));
+    return 0;
+}
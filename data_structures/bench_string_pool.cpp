@@ -0,0 +1,89 @@
+#include "String/String.hpp"
+#include "String/StringPool.hpp"
+#include "timeProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// identifiers with long common prefixes, as in structured log keys
+std::vector<String> MakeIdentifiers(size_t count) {
+    std::vector<String> identifiers;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string name = "service.request.headers.field_" + std::to_string(i);
+        identifiers.emplace_back(name.c_str(), name.size());
+    }
+    return identifiers;
+}
+
+// million Intern calls per second over all threads, nearly all of them hits
+double InternThroughput(const std::vector<String>& identifiers, size_t threads, size_t ops_per_thread) {
+    StringPool pool;
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&pool, &identifiers, t, ops_per_thread]() {
+            std::mt19937 generator(static_cast<unsigned>(t + 1));
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                pool.Intern(identifiers[generator() % identifiers.size()]);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(threads * ops_per_thread) / elapsed.count() / 1e6;
+}
+
+int main() {
+    const size_t kIdentifiers = 4096;
+    const size_t kCompares = 20'000'000;
+    const size_t kInterns = 2'000'000;
+
+    const std::vector<String> identifiers = MakeIdentifiers(kIdentifiers);
+    StringPool pool;
+    std::vector<InternedString> interned;
+    for (const String& identifier : identifiers) {
+        interned.push_back(pool.Intern(identifier));
+    }
+
+    std::vector<uint32_t> pairs(2 * kCompares);
+    std::mt19937 generator(1);
+    for (uint32_t& index : pairs) {
+        // every other pair is equal, so the compare cannot bail out early
+        index = generator() % kIdentifiers;
+    }
+    for (size_t i = 0; i < pairs.size(); i += 4) {
+        pairs[i + 1] = pairs[i];
+    }
+
+    std::cout << kCompares << " compares of " << kIdentifiers << " identifiers\n";
+    size_t equal = 0;
+    {
+        TimeProfiler profiler("    String ==");
+        for (size_t i = 0; i < pairs.size(); i += 2) {
+            equal += identifiers[pairs[i]] == identifiers[pairs[i + 1]];
+        }
+    }
+    {
+        TimeProfiler profiler("    InternedString ==");
+        for (size_t i = 0; i < pairs.size(); i += 2) {
+            equal += interned[pairs[i]] == interned[pairs[i + 1]];
+        }
+    }
+    std::cout << "    equal: " << equal << '\n';
+
+    const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+    std::cout << "Intern, Mops/s\n";
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << "    " << threads << " threads: "
+                  << InternThroughput(identifiers, threads, kInterns / threads) << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "forwardList.h"
+#include "timeProfiler.h"
+#include "unrolledForwardList.h"
+
+#include <cstdint>
+#include <iostream>
+
+// a value that takes a cache line of its own
+struct Payload64 {
+    int64_t key_;
+    char data_[56];
+
+    Payload64(int64_t key) : key_(key), data_() {
+    }
+};
+
+int64_t KeyOf(int value) {
+    return value;
+}
+
+int64_t KeyOf(const Payload64& value) {
+    return value.key_;
+}
+
+template <class ListType>
+void Run(const char* info, const int count, const int scans) {
+    std::cout << info << '\n';
+    ListType list;
+    {
+        TimeProfiler profiler("    push_front");
+        for (int i = 0; i < count; ++i) {
+            list.push_front(i);
+        }
+    }
+
+    int64_t sum = 0;
+    {
+        TimeProfiler profiler("    scan");
+        for (int pass = 0; pass < scans; ++pass) {
+            for (const auto& value : list) {
+                sum += KeyOf(value);
+            }
+        }
+    }
+    std::cout << "    checksum: " << sum << '\n';
+}
+
+int main() {
+    const int kSmall = 10'000'000;
+    const int kLarge = 2'000'000;
+    const int kScans = 10;
+
+    Run<ForwardList<int>>("ForwardList<int>", kSmall, kScans);
+    Run<UnrolledForwardList<int>>("UnrolledForwardList<int>", kSmall, kScans);
+    Run<ForwardList<Payload64>>("ForwardList<Payload64>", kLarge, kScans);
+    Run<UnrolledForwardList<Payload64>>("UnrolledForwardList<Payload64>", kLarge, kScans);
+
+    return 0;
+}
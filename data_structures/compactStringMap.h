@@ -0,0 +1,207 @@
+#ifndef COMPACTSTRINGMAP_H
+#define COMPACTSTRINGMAP_H
+
+#include "hash64.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// String-keyed Robin Hood map that keeps every key in one contiguous arena.
+// A slot is 16 bytes: where its key lives in the arena, the key length, the
+// upper half of its hash and its probe distance. Values sit in a parallel
+// array. Deleted keys leave dead bytes in the arena, which is compacted
+// once they outweigh the live ones. The arena is addressed with 32-bit
+// offsets, so it holds at most 4 GiB of keys.
+template <class V>
+class CompactStringMap {
+public:
+    CompactStringMap() : non_empty_(0), dead_bytes_(0), slots_(8), values_(8) {
+    }
+
+    long double GetLoadFactor() const {
+        return static_cast<long double>(non_empty_) / static_cast<long double>(slots_.size());
+    }
+
+    bool Add(std::string_view key, V value = V()) {
+        const uint64_t hash = Hash64<std::string_view>()(key);
+        if (FindIndex(key, hash) != slots_.size()) {
+            return false;
+        }
+
+        if (static_cast<long double>(non_empty_ + 1) / slots_.size() >= 0.75) {
+            Rehash(slots_.size() * 2);
+        }
+
+        if (arena_.size() + key.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("CompactStringMap arena exceeds 4 GiB");
+        }
+        Slot slot{static_cast<uint32_t>(arena_.size()), static_cast<uint32_t>(key.size()), Tag(hash), 0};
+        arena_.insert(arena_.end(), key.begin(), key.end());
+        Insert(slot, std::move(value), hash);
+        ++non_empty_;
+        return true;
+    }
+
+    V* Find(std::string_view key) {
+        const size_t idx = FindIndex(key, Hash64<std::string_view>()(key));
+        return idx == slots_.size() ? nullptr : &values_[idx].value_;
+    }
+
+    const V* Find(std::string_view key) const {
+        const size_t idx = FindIndex(key, Hash64<std::string_view>()(key));
+        return idx == slots_.size() ? nullptr : &values_[idx].value_;
+    }
+
+    bool Contains(std::string_view key) const {
+        return Find(key) != nullptr;
+    }
+
+    bool Delete(std::string_view key) {
+        size_t idx = FindIndex(key, Hash64<std::string_view>()(key));
+        if (idx == slots_.size()) {
+            return false;
+        }
+
+        dead_bytes_ += slots_[idx].length_;
+        --non_empty_;
+
+        // backward shift, as in HashMap
+        const size_t mask = slots_.size() - 1;
+        size_t next = (idx + 1) & mask;
+        while (slots_[next].dist_ != kFree && slots_[next].dist_ > 0) {
+            slots_[idx] = slots_[next];
+            --slots_[idx].dist_;
+            values_[idx] = std::move(values_[next]);
+            idx = next;
+            next = (next + 1) & mask;
+        }
+        slots_[idx] = Slot();
+        values_[idx] = Cell();
+
+        if (dead_bytes_ > arena_.size() / 2) {
+            Rehash(slots_.size());
+        }
+        return true;
+    }
+
+    template <class F>
+    void ForEach(F&& func) const {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].dist_ != kFree) {
+                func(KeyAt(slots_[i]), values_[i].value_);
+            }
+        }
+    }
+
+    size_t Count() const {
+        return non_empty_;
+    }
+
+    size_t Size() const {
+        return slots_.size();
+    }
+
+    // bytes held by the slots, the values and the key arena
+    size_t MemoryUsage() const {
+        return slots_.capacity() * sizeof(Slot) + values_.capacity() * sizeof(Cell) + arena_.capacity();
+    }
+
+private:
+    static const uint32_t kFree = std::numeric_limits<uint32_t>::max();
+
+    struct Slot {
+        uint32_t offset_ = 0;
+        uint32_t length_ = 0;
+        // upper half of the hash, checked before touching the arena
+        uint32_t tag_ = 0;
+        uint32_t dist_ = kFree;
+    };
+
+    // keeps std::vector<bool> from packing the values into bits
+    struct Cell {
+        V value_ = V();
+    };
+
+    size_t non_empty_;
+    size_t dead_bytes_;
+    std::vector<Slot> slots_;
+    std::vector<Cell> values_;
+    std::vector<char> arena_;
+
+    static uint32_t Tag(uint64_t hash) {
+        return static_cast<uint32_t>(hash >> 32);
+    }
+
+    std::string_view KeyAt(const Slot& slot) const {
+        return std::string_view(arena_.data() + slot.offset_, slot.length_);
+    }
+
+    size_t FindIndex(std::string_view key, uint64_t hash) const {
+        const size_t mask = slots_.size() - 1;
+        const uint32_t tag = Tag(hash);
+        size_t idx = hash & mask;
+
+        for (uint32_t dist = 0; dist < slots_.size(); ++dist) {
+            const Slot& slot = slots_[idx];
+            if (slot.dist_ == kFree || slot.dist_ < dist) {
+                return slots_.size();
+            } else if (slot.tag_ == tag && KeyAt(slot) == key) {
+                return idx;
+            }
+
+            idx = (idx + 1) & mask;
+        }
+
+        return slots_.size();
+    }
+
+    void Insert(Slot slot, V value, uint64_t hash) {
+        const size_t mask = slots_.size() - 1;
+        size_t idx = hash & mask;
+        slot.dist_ = 0;
+
+        while (slots_[idx].dist_ != kFree) {
+            if (slots_[idx].dist_ < slot.dist_) {
+                std::swap(slots_[idx], slot);
+                std::swap(values_[idx].value_, value);
+            }
+
+            idx = (idx + 1) & mask;
+            ++slot.dist_;
+        }
+
+        slots_[idx] = slot;
+        values_[idx].value_ = std::move(value);
+    }
+
+    // rebuilds the table with new_size slots and a fresh arena of live keys only
+    void Rehash(size_t new_size) {
+        std::vector<Slot> old_slots(new_size);
+        std::vector<Cell> old_values(new_size);
+        std::vector<char> old_arena;
+        old_arena.reserve(arena_.size() - dead_bytes_);
+        // after the swaps the old_ vectors really hold the old contents
+        old_slots.swap(slots_);
+        old_values.swap(values_);
+        old_arena.swap(arena_);
+
+        for (size_t i = 0; i < old_slots.size(); ++i) {
+            Slot slot = old_slots[i];
+            if (slot.dist_ == kFree) {
+                continue;
+            }
+
+            const std::string_view key(old_arena.data() + slot.offset_, slot.length_);
+            slot.offset_ = static_cast<uint32_t>(arena_.size());
+            arena_.insert(arena_.end(), key.begin(), key.end());
+            Insert(slot, std::move(old_values[i].value_), Hash64<std::string_view>()(key));
+        }
+        dead_bytes_ = 0;
+    }
+};
+
+#endif //COMPACTSTRINGMAP_H
@@ -0,0 +1,116 @@
+#ifndef CONCURRENTHASHMAP_H
+#define CONCURRENTHASHMAP_H
+
+#include "hashTable.h"
+#include "lockedShard.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+// HashMap split into independently locked shards, picked by ShardOfHash.
+// Readers of a shard share its lock; values are handed out by copy or
+// visited under the lock, never by pointer.
+template <class K, class V, class Hash = Hash64<K>, class KeyEqual = std::equal_to<>>
+class ConcurrentHashMap {
+public:
+    explicit ConcurrentHashMap(size_t shard_count = 64)
+            : shard_bits_(ShardBits(shard_count)), shards_(std::make_unique<Shard[]>(size_t(1) << shard_bits_)) {
+    }
+
+    ConcurrentHashMap(const ConcurrentHashMap& other) = delete;
+
+    ConcurrentHashMap& operator=(const ConcurrentHashMap& other) = delete;
+
+    ~ConcurrentHashMap() = default;
+
+    bool Add(const K& key, V value = V()) {
+        const uint64_t hash = hasher_(key);
+        Shard& shard = ShardFor(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        return shard.data_.TryEmplaceWithHash(key, hash, std::move(value)).second;
+    }
+
+    // sets the value whether or not key was present; true if it was inserted
+    template <class M>
+    bool InsertOrAssign(const K& key, M&& value) {
+        const uint64_t hash = hasher_(key);
+        Shard& shard = ShardFor(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        return shard.data_.InsertOrAssignWithHash(key, hash, std::forward<M>(value)).second;
+    }
+
+    bool Contains(const K& key) const {
+        const uint64_t hash = hasher_(key);
+        const Shard& shard = ShardFor(hash);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+        return shard.data_.FindWithHash(key, hash) != nullptr;
+    }
+
+    std::optional<V> Search(const K& key) const {
+        const uint64_t hash = hasher_(key);
+        const Shard& shard = ShardFor(hash);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex_);
+        if (const V* found = shard.data_.FindWithHash(key, hash)) {
+            return *found;
+        }
+        return std::nullopt;
+    }
+
+    // calls func(V&) under the shard's exclusive lock if key is present
+    template <class F>
+    bool Visit(const K& key, F&& func) {
+        const uint64_t hash = hasher_(key);
+        Shard& shard = ShardFor(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        if (V* found = shard.data_.FindWithHash(key, hash)) {
+            func(*found);
+            return true;
+        }
+        return false;
+    }
+
+    bool Delete(const K& key) {
+        const uint64_t hash = hasher_(key);
+        Shard& shard = ShardFor(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex_);
+        return shard.data_.DeleteWithHash(key, hash);
+    }
+
+    // not a snapshot: shards are counted one after another
+    size_t Count() const {
+        size_t count = 0;
+        for (size_t i = 0; i < ShardCount(); ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mutex_);
+            count += shards_[i].data_.Count();
+        }
+        return count;
+    }
+
+    size_t ShardCount() const {
+        return size_t(1) << shard_bits_;
+    }
+
+private:
+    using Shard = LockedShard<std::shared_mutex, HashMap<K, V, Hash, KeyEqual>>;
+
+    size_t shard_bits_;
+    std::unique_ptr<Shard[]> shards_;
+    Hash hasher_;
+
+    // the same hash then probes the shard's table, so keys are hashed once
+    Shard& ShardFor(uint64_t hash) {
+        return shards_[ShardOfHash(hash, shard_bits_)];
+    }
+
+    const Shard& ShardFor(uint64_t hash) const {
+        return shards_[ShardOfHash(hash, shard_bits_)];
+    }
+};
+
+#endif //CONCURRENTHASHMAP_H
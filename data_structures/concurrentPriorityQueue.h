@@ -0,0 +1,201 @@
+#ifndef CONCURRENTPRIORITYQUEUE_H
+#define CONCURRENTPRIORITYQUEUE_H
+
+#include "hash64.h"
+#include "lockedShard.h"
+#include "priorityQueue.h"
+#include "smallVector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Relaxed priority queue for many threads (a MultiQueue): elements are
+// spread over several PriorityQueues with a lock each. Push goes to a
+// random queue; Pop looks at the tops of `choices` random queues and takes
+// the best of them. The popped element is therefore not always the global
+// top, but close to it, and threads rarely meet on the same lock.
+//
+// choices sets the strictness: 1 pops from a random queue, 2 is the usual
+// MultiQueue trade-off, and choices equal to the number of queues (at most
+// kMaxChoices) locks all of them and behaves like a single PriorityQueue.
+template <
+        class T,
+        class Compare = std::less<T>,
+        class Layout = BinaryHeap
+> class ConcurrentPriorityQueue {
+public:
+    static constexpr size_t kMaxChoices = 8;
+
+    explicit ConcurrentPriorityQueue(size_t queue_count = DefaultQueueCount(), size_t choices = 2)
+            : queue_count_(std::max<size_t>(queue_count, 1)),
+              choices_(std::min({std::max<size_t>(choices, 1), queue_count_, kMaxChoices})),
+              queues_(std::make_unique<Shard[]>(queue_count_)),
+              size_(0) {
+    }
+
+    ConcurrentPriorityQueue(const ConcurrentPriorityQueue& other) = delete;
+
+    ConcurrentPriorityQueue& operator=(const ConcurrentPriorityQueue& other) = delete;
+
+    ~ConcurrentPriorityQueue() = default;
+
+    void Push(const T& item) {
+        Emplace(item);
+    }
+
+    void Push(T&& item) {
+        Emplace(std::move(item));
+    }
+
+    template <class... Args>
+    void Emplace(Args&&... args) {
+        // a busy queue is skipped once, after that we wait for the next one
+        Shard* shard = &queues_[NextRandom() % queue_count_];
+        std::unique_lock<std::mutex> lock(shard->mutex_, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            shard = &queues_[NextRandom() % queue_count_];
+            lock = std::unique_lock<std::mutex>(shard->mutex_);
+        }
+        shard->data_.Emplace(std::forward<Args>(args)...);
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // a copy of the best top among the sampled queues
+    std::optional<T> Top() const {
+        Locks locks;
+        const size_t best = LockBest(locks);
+        if (best == kNone) {
+            return std::nullopt;
+        }
+        return queues_[best].data_.Top();
+    }
+
+    // empty only if the whole queue was found empty
+    std::optional<T> Pop() {
+        std::optional<T> result;
+        {
+            Locks locks;
+            const size_t best = LockBest(locks);
+            if (best != kNone) {
+                result = PopFrom(queues_[best]);
+            }
+        }
+        if (!result && !Empty()) {
+            result = PopAny();
+        }
+        return result;
+    }
+
+    bool TryPop(T& item) {
+        std::optional<T> result = Pop();
+        if (result) {
+            item = std::move(*result);
+        }
+        return result.has_value();
+    }
+
+    // exact only while no other thread pushes or pops
+    size_t Size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    bool Empty() const {
+        return Size() == 0;
+    }
+
+    size_t QueueCount() const {
+        return queue_count_;
+    }
+
+    size_t Choices() const {
+        return choices_;
+    }
+
+private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+
+    using Queue = PriorityQueue<T, std::vector<T>, Compare, Layout>;
+    using Locks = SmallVector<std::unique_lock<std::mutex>, kMaxChoices>;
+
+    using Shard = LockedShard<std::mutex, Queue>;
+
+    size_t queue_count_;
+    size_t choices_;
+    std::unique_ptr<Shard[]> queues_;
+    std::atomic<size_t> size_;
+    Compare comp_;
+
+    static size_t DefaultQueueCount() {
+        return 2 * std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // xorshift with a per-thread state, cheaper than a shared generator
+    static uint64_t NextRandom() {
+        thread_local uint64_t state = Mix64(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // locks `choices_` distinct queues in index order, so that two threads
+    // cannot deadlock, and returns the one with the best top
+    size_t LockBest(Locks& locks) const {
+        SmallVector<size_t, kMaxChoices> picked;
+        if (choices_ == queue_count_) {
+            for (size_t i = 0; i < queue_count_; ++i) {
+                picked.PushBack(i);
+            }
+        } else {
+            while (picked.Size() < choices_) {
+                const size_t idx = NextRandom() % queue_count_;
+                if (std::find(picked.Data(), picked.Data() + picked.Size(), idx) == picked.Data() + picked.Size()) {
+                    picked.PushBack(idx);
+                }
+            }
+            std::sort(picked.Data(), picked.Data() + picked.Size());
+        }
+
+        size_t best = kNone;
+        for (size_t i = 0; i < picked.Size(); ++i) {
+            const size_t idx = picked[i];
+            locks.EmplaceBack(queues_[idx].mutex_);
+            const Queue& queue = queues_[idx].data_;
+            if (!queue.Empty() && (best == kNone || comp_(queues_[best].data_.Top(), queue.Top()))) {
+                best = idx;
+            }
+        }
+        return best;
+    }
+
+    T PopFrom(Shard& shard) {
+        T item = std::move(shard.data_.Top());
+        shard.data_.Pop();
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return item;
+    }
+
+    // the sampled queues were empty while others may not be
+    std::optional<T> PopAny() {
+        const size_t start = NextRandom() % queue_count_;
+        for (size_t i = 0; i < queue_count_; ++i) {
+            Shard& shard = queues_[(start + i) % queue_count_];
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            if (!shard.data_.Empty()) {
+                return PopFrom(shard);
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+#endif //CONCURRENTPRIORITYQUEUE_H
@@ -0,0 +1,375 @@
+#ifndef FLATHASHMAP_H
+#define FLATHASHMAP_H
+
+#include "hash64.h"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Control byte of a slot: a 7-bit fragment of the hash when the slot is
+// full, otherwise one of the negative markers below.
+constexpr int8_t kCtrlEmpty = -128;
+constexpr int8_t kCtrlDeleted = -2;
+
+// Bit i of a mask answers the question for slot i of the group
+// (for the portable group the answer sits in bit 8 * i + 7).
+class BitMask {
+public:
+    BitMask(uint64_t mask, int shift) : mask_(mask), shift_(shift) {
+    }
+
+    explicit operator bool() const {
+        return mask_ != 0;
+    }
+
+    size_t Lowest() const {
+        return static_cast<size_t>(__builtin_ctzll(mask_)) >> shift_;
+    }
+
+    void ClearLowest() {
+        mask_ &= mask_ - 1;
+    }
+
+private:
+    uint64_t mask_;
+    int shift_;
+};
+
+#if defined(__AVX2__)
+
+struct Group {
+    static const size_t kWidth = 32;
+
+    __m256i ctrl_;
+
+    explicit Group(const int8_t* pos) : ctrl_(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {
+    }
+
+    BitMask Match(int8_t h2) const {
+        return Movemask(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), ctrl_));
+    }
+
+    BitMask MatchEmpty() const {
+        return Match(kCtrlEmpty);
+    }
+
+    // both markers are negative, so the sign bits are exactly the non-full slots
+    BitMask MatchEmptyOrDeleted() const {
+        return Movemask(ctrl_);
+    }
+
+    static BitMask Movemask(__m256i bytes) {
+        return BitMask(static_cast<uint32_t>(_mm256_movemask_epi8(bytes)), 0);
+    }
+};
+
+#elif defined(__SSE2__)
+
+struct Group {
+    static const size_t kWidth = 16;
+
+    __m128i ctrl_;
+
+    explicit Group(const int8_t* pos) : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {
+    }
+
+    BitMask Match(int8_t h2) const {
+        return Movemask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+    }
+
+    BitMask MatchEmpty() const {
+        return Match(kCtrlEmpty);
+    }
+
+    BitMask MatchEmptyOrDeleted() const {
+        return Movemask(ctrl_);
+    }
+
+    static BitMask Movemask(__m128i bytes) {
+        return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(bytes)), 0);
+    }
+};
+
+#else
+
+// eight control bytes handled at once inside a 64-bit word
+struct Group {
+    static const size_t kWidth = 8;
+
+    static const uint64_t kLsbs = 0x0101010101010101ULL;
+    static const uint64_t kMsbs = 0x8080808080808080ULL;
+
+    uint64_t ctrl_;
+
+    explicit Group(const int8_t* pos) {
+        std::memcpy(&ctrl_, pos, sizeof(ctrl_));
+    }
+
+    // may report false positives, the key comparison filters them out
+    BitMask Match(int8_t h2) const {
+        uint64_t x = ctrl_ ^ (kLsbs * static_cast<uint8_t>(h2));
+        return BitMask((x - kLsbs) & ~x & kMsbs, 3);
+    }
+
+    BitMask MatchEmpty() const {
+        return BitMask(ctrl_ & (~ctrl_ << 6) & kMsbs, 3);
+    }
+
+    BitMask MatchEmptyOrDeleted() const {
+        return BitMask(ctrl_ & kMsbs, 3);
+    }
+};
+
+#endif
+
+// Open-addressing map in the spirit of Abseil's Swiss table: control bytes
+// live in their own array and a whole group of them is tested per probe.
+template <class K, class V, class Hash = Hash64<K>, class KeyEqual = std::equal_to<K>>
+class FlatHashMap {
+public:
+    using value_type = std::pair<K, V>;
+
+    FlatHashMap() : ctrl_(nullptr), slots_(nullptr), size_(0), capacity_(0), growth_left_(0) {
+    }
+
+    FlatHashMap(const FlatHashMap& other) : FlatHashMap() {
+        Reserve(other.size_);
+        other.ForEach([this](const K& key, const V& value) {
+            Add(key, value);
+        });
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept : FlatHashMap() {
+        Swap(other);
+    }
+
+    FlatHashMap& operator=(FlatHashMap other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~FlatHashMap() {
+        Clear();
+        ::operator delete(ctrl_);
+        ::operator delete(slots_);
+    }
+
+    long double GetLoadFactor() const {
+        return capacity_ == 0 ? 0 : static_cast<long double>(size_) / static_cast<long double>(capacity_);
+    }
+
+    bool Add(const K& key, V value = V()) {
+        const uint64_t hash = hasher_(key);
+        if (FindIndex(key, hash) != kNotFound) {
+            return false;
+        }
+
+        const size_t idx = PrepareInsert(hash);
+        new (slots_ + idx) value_type(key, std::move(value));
+        return true;
+    }
+
+    V* Search(const K& key) {
+        const size_t idx = FindIndex(key, hasher_(key));
+        return idx == kNotFound ? nullptr : &slots_[idx].second;
+    }
+
+    const V* Search(const K& key) const {
+        const size_t idx = FindIndex(key, hasher_(key));
+        return idx == kNotFound ? nullptr : &slots_[idx].second;
+    }
+
+    bool Delete(const K& key) {
+        const size_t idx = FindIndex(key, hasher_(key));
+        if (idx == kNotFound) {
+            return false;
+        }
+
+        slots_[idx].~value_type();
+        --size_;
+        // a probe only walks past a group that had no empty slot, so if this
+        // group still has one nobody's probe sequence runs through it
+        if (Group(ctrl_ + GroupStart(idx)).MatchEmpty()) {
+            ctrl_[idx] = kCtrlEmpty;
+            ++growth_left_;
+        } else {
+            ctrl_[idx] = kCtrlDeleted;
+        }
+        return true;
+    }
+
+    void Reserve(size_t count) {
+        size_t new_capacity = capacity_ == 0 ? Group::kWidth : capacity_;
+        while (MaxLoad(new_capacity) < count) {
+            new_capacity *= 2;
+        }
+        if (new_capacity > capacity_) {
+            Resize(new_capacity);
+        }
+    }
+
+    void Clear() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                slots_[i].~value_type();
+            }
+            ctrl_[i] = kCtrlEmpty;
+        }
+        size_ = 0;
+        growth_left_ = MaxLoad(capacity_);
+    }
+
+    template <class F>
+    void ForEach(F&& func) const {
+        for (size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                func(slots_[i].first, slots_[i].second);
+            }
+        }
+    }
+
+    void Swap(FlatHashMap& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(growth_left_, other.growth_left_);
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    size_t Capacity() const {
+        return capacity_;
+    }
+
+private:
+    static const size_t kNotFound = static_cast<size_t>(-1);
+
+    int8_t* ctrl_;
+    value_type* slots_;
+    size_t size_;
+    size_t capacity_;
+    // empty slots that may still be filled before the 7/8 load limit
+    size_t growth_left_;
+    Hash hasher_;
+    KeyEqual equal_;
+
+    static size_t MaxLoad(size_t capacity) {
+        return capacity - capacity / 8;
+    }
+
+    static size_t H1(uint64_t hash) {
+        return static_cast<size_t>(hash >> 7);
+    }
+
+    static int8_t H2(uint64_t hash) {
+        return static_cast<int8_t>(hash & 0x7f);
+    }
+
+    static size_t GroupStart(size_t idx) {
+        return idx & ~(Group::kWidth - 1);
+    }
+
+    // groups are visited in triangular order, which covers all of them
+    // because their number is a power of two
+    size_t FindIndex(const K& key, uint64_t hash) const {
+        if (capacity_ == 0) {
+            return kNotFound;
+        }
+
+        const size_t group_mask = capacity_ / Group::kWidth - 1;
+        size_t group = H1(hash) & group_mask;
+        for (size_t step = 1;; ++step) {
+            const size_t start = group * Group::kWidth;
+            Group grp(ctrl_ + start);
+            for (BitMask match = grp.Match(H2(hash)); match; match.ClearLowest()) {
+                const size_t idx = start + match.Lowest();
+                if (equal_(slots_[idx].first, key)) {
+                    return idx;
+                }
+            }
+            if (grp.MatchEmpty()) {
+                return kNotFound;
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+
+    size_t FindFirstNonFull(uint64_t hash) const {
+        const size_t group_mask = capacity_ / Group::kWidth - 1;
+        size_t group = H1(hash) & group_mask;
+        for (size_t step = 1;; ++step) {
+            const size_t start = group * Group::kWidth;
+            BitMask free = Group(ctrl_ + start).MatchEmptyOrDeleted();
+            if (free) {
+                return start + free.Lowest();
+            }
+            group = (group + step) & group_mask;
+        }
+    }
+
+    size_t PrepareInsert(uint64_t hash) {
+        if (growth_left_ == 0) {
+            // tombstones alone can exhaust growth_left_; then a rehash
+            // at the same capacity is enough to get rid of them
+            Resize(capacity_ == 0 ? Group::kWidth
+                                  : (size_ < MaxLoad(capacity_) / 2 ? capacity_ : 2 * capacity_));
+        }
+
+        size_t idx = FindFirstNonFull(hash);
+        if (ctrl_[idx] == kCtrlEmpty) {
+            --growth_left_;
+        }
+        ctrl_[idx] = H2(hash);
+        ++size_;
+        return idx;
+    }
+
+    void Resize(size_t new_capacity) {
+        int8_t* old_ctrl = ctrl_;
+        value_type* old_slots = slots_;
+        const size_t old_capacity = capacity_;
+
+        ctrl_ = static_cast<int8_t*>(::operator new(new_capacity));
+        std::memset(ctrl_, kCtrlEmpty, new_capacity);
+        try {
+            slots_ = static_cast<value_type*>(::operator new(new_capacity * sizeof(value_type)));
+        } catch (...) {
+            ::operator delete(ctrl_);
+            ctrl_ = old_ctrl;
+            throw;
+        }
+        capacity_ = new_capacity;
+        growth_left_ = MaxLoad(new_capacity) - size_;
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                const uint64_t hash = hasher_(old_slots[i].first);
+                const size_t idx = FindFirstNonFull(hash);
+                ctrl_[idx] = H2(hash);
+                new (slots_ + idx) value_type(std::move(old_slots[i]));
+                old_slots[i].~value_type();
+            }
+        }
+
+        ::operator delete(old_ctrl);
+        ::operator delete(old_slots);
+    }
+};
+
+#endif //FLATHASHMAP_H
@@ -1,64 +1,58 @@
 #ifndef FORWARDLIST_H
 #define FORWARDLIST_H
 
+#include "nodePool.h"
+
 #include <cstddef>
+#include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 template <typename T>
 struct Node {
-    using NodePtr = std::unique_ptr<Node<T> >;
-
     T value_;
-    NodePtr next_;
-
-    Node() = default;
+    Node* next_;
 
-    explicit Node(const T& value) : value_(value), next_(nullptr) {
+    template <class... Args>
+    explicit Node(Node* next, Args&&... args) : value_(std::forward<Args>(args)...), next_(next) {
     }
 
-    Node(const T& value, NodePtr to)
-            : value_(value),
-              next_(std::move(to)) {}
-
     Node(const Node& other) = delete;
 
     Node& operator=(const Node& other) = delete;
 
-    Node(Node&& other) noexcept = default;
-
-    Node& operator=(Node&& other) noexcept {
-        std::swap(value_, other.value_);
-        std::swap(next_, other.next_);
-        return *this;
-    }
-
     ~Node() = default;
 };
 
-template <typename T>
+// Nodes come from a pool owned by the list, which takes them from the
+// allocator a slab at a time: pop_front recycles a node for the next push,
+// and the memory itself is returned by clear() and the destructor.
+template <typename T, class Allocator = std::allocator<T>>
 class ForwardList {
-    using NodePtr = typename Node<T>::NodePtr;
+    using NodeAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<Node<T>>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
 public:
     using value_type = T;
     using size_type = std::size_t;
+    using allocator_type = Allocator;
 
     class Iterator {
     public:
         Iterator() = default;
 
-        Iterator(const NodePtr& ptr) : it_(ptr.get()) {
+        Iterator(Node<T>* ptr) : it_(ptr) {
         }
 
         Iterator& operator++() {
-            it_ = it_->next_.get();
+            it_ = it_->next_;
             return *this;
         }
 
         Iterator operator++(int) {
             Iterator tmp = *this;
-            it_ = it_->next_.get();
+            it_ = it_->next_;
             return tmp;
         }
 
@@ -70,8 +64,8 @@ public:
             return it_->value_;
         }
 
-        NodePtr operator->() {
-            return it_;
+        T* operator->() {
+            return &it_->value_;
         }
 
         bool operator!=(const Iterator& other) {
@@ -89,40 +83,30 @@ public:
     using iterator = Iterator;
     using const_iterator = Iterator;
 
-    ForwardList() = default;
+    ForwardList() : ForwardList(Allocator()) {
+    }
+
+    explicit ForwardList(const Allocator& alloc) : alloc_(alloc), size_(0), head_(nullptr) {
+    }
 
-    ForwardList(const size_t size, const T& value) : size_(0) {
+    ForwardList(const size_t size, const T& value, const Allocator& alloc = Allocator()) : ForwardList(alloc) {
         for (size_t i = 0; i < size; ++i) {
             push_front(value);
         }
     }
 
-    ForwardList(std::initializer_list<T> i_list) : size_(0) {
-        for (auto it = i_list.end() - 1; it >= i_list.begin(); --it) {
-            push_front(*it);
-        }
+    ForwardList(std::initializer_list<T> i_list, const Allocator& alloc = Allocator()) : ForwardList(alloc) {
+        AppendRange(i_list.begin(), i_list.end());
     }
 
-    ForwardList(const ForwardList& other) : size_(other.size_) {
-        Node<T>* curr = other.head_.get();
-        NodePtr new_head{nullptr};
-        Node<T>* new_head_ptr{nullptr};
-
-        while (curr) {
-            auto tmp = std::make_unique<Node<T>>(curr->value_);
-
-            if (!new_head) {
-                new_head = std::move(tmp);
-                new_head_ptr = new_head.get();
-            } else {
-                new_head_ptr->next_ = std::move(tmp);
-                new_head_ptr = new_head_ptr->next_.get();
-            }
-
-            curr = curr->next_.get();
-        }
+    template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    ForwardList(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : ForwardList(alloc) {
+        AppendRange(first, last);
+    }
 
-        head_ = std::move(new_head);
+    ForwardList(const ForwardList& other)
+            : ForwardList(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        AppendRange(other.cbegin(), other.cend());
     }
 
     ForwardList& operator=(const ForwardList& other) {
@@ -130,14 +114,19 @@ public:
         return *this;
     }
 
-    ForwardList(ForwardList&& other) noexcept = default;
+    ForwardList(ForwardList&& other) noexcept : ForwardList(other.alloc_) {
+        Swap(other);
+    }
 
     ForwardList& operator=(ForwardList&& other) noexcept {
         Swap(other);
         return *this;
     };
 
-    ~ForwardList() = default;
+    // iterative, so that long lists do not exhaust the stack
+    ~ForwardList() {
+        clear();
+    }
 
     iterator begin() {
         return iterator(head_);
@@ -156,38 +145,45 @@ public:
     }
 
     void reverse() {
-        NodePtr curr = std::move(head_);
-        NodePtr next;
-        NodePtr prev;
+        Node<T>* curr = head_;
+        Node<T>* prev = nullptr;
 
         while (curr) {
-            next = std::move(curr->next_);
-            curr->next_ = std::move(prev);
-            prev = std::move(curr);
-            curr = std::move(next);
+            Node<T>* next = curr->next_;
+            curr->next_ = prev;
+            prev = curr;
+            curr = next;
         }
 
-        head_ = std::move(prev);
+        head_ = prev;
     }
 
     void push_front(const T& value) {
-        NodePtr new_node = std::make_unique<Node<T>>(value, std::move(head_));
-        head_ = std::move(new_node);
-        ++size_;
+        emplace_front(value);
     }
 
     void pop_front() {
         if (size_ != 0) {
-            auto tmp = std::move(head_);
-            head_ = std::move(tmp->next_);
+            Node<T>* tmp = head_;
+            head_ = head_->next_;
+            DestroyNode(tmp);
             --size_;
         }
     }
 
+    // a walk over the nodes to run the destructors (none for trivial T),
+    // then one deallocation per slab rather than one per node
     void clear() {
-        while (size_ > 0) {
-            pop_front();
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (Node<T>* node = head_; node != nullptr;) {
+                Node<T>* next = node->next_;
+                NodeTraits::destroy(alloc_, node);
+                node = next;
+            }
         }
+        head_ = nullptr;
+        size_ = 0;
+        pool_.Release(alloc_);
     }
 
     T& front() {
@@ -204,19 +200,57 @@ public:
 
     template <class... Args>
     void emplace_front(Args&& ... args) {
-        NodePtr tmp = std::make_unique<Node<T>>(T(std::forward<Args>(args)...), std::move(head_));
-        head_ = std::move(tmp);
+        head_ = CreateNode(head_, std::forward<Args>(args)...);
         ++size_;
     }
 
+    allocator_type get_allocator() const {
+        return allocator_type(alloc_);
+    }
+
 private:
+    NodeAlloc alloc_;
+    NodePool<Node<T>, NodeAlloc> pool_;
     size_t size_;
-    NodePtr head_;
+    Node<T>* head_;
 
     void Swap(ForwardList& other) {
+        std::swap(alloc_, other.alloc_);
+        pool_.Swap(other.pool_);
         std::swap(head_, other.head_);
         std::swap(size_, other.size_);
     }
+
+    template <class... Args>
+    Node<T>* CreateNode(Node<T>* next, Args&& ... args) {
+        Node<T>* node = pool_.Allocate(alloc_);
+        try {
+            NodeTraits::construct(alloc_, node, next, std::forward<Args>(args)...);
+        } catch (...) {
+            pool_.Deallocate(node);
+            throw;
+        }
+        return node;
+    }
+
+    void DestroyNode(Node<T>* node) {
+        NodeTraits::destroy(alloc_, node);
+        pool_.Deallocate(node);
+    }
+
+    template <class InputIt>
+    void AppendRange(InputIt first, InputIt last) {
+        Node<T>** tail = &head_;
+        while (*tail) {
+            tail = &(*tail)->next_;
+        }
+
+        for (; first != last; ++first) {
+            *tail = CreateNode(nullptr, *first);
+            tail = &(*tail)->next_;
+            ++size_;
+        }
+    }
 };
 
 #endif //FORWARDLIST_H
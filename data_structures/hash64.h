@@ -0,0 +1,85 @@
+#ifndef HASH64_H
+#define HASH64_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// 64x64 -> 128 bit multiply folded back to 64 bits
+inline uint64_t MulFold(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = static_cast<__uint128_t>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+    uint64_t lo = a * b;
+    uint64_t hi = (a >> 32) * (b >> 32) + (((a & 0xffffffffULL) * (b >> 32)) >> 32)
+            + (((a >> 32) * (b & 0xffffffffULL)) >> 32);
+    return lo ^ hi;
+#endif
+}
+
+// finalizer of MurmurHash3, every input bit affects every output bit
+inline uint64_t Mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// reads the string eight bytes at a time instead of one character per step
+inline uint64_t HashBytes(const char* data, size_t size, uint64_t seed = 0) {
+    const uint64_t kSecret0 = 0xa0761d6478bd642fULL;
+    const uint64_t kSecret1 = 0xe7037ed1a0b428dbULL;
+    const uint64_t kSecret2 = 0x8ebc6af09c88c6e3ULL;
+
+    uint64_t h = seed ^ kSecret0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h = MulFold(word ^ kSecret1, h ^ kSecret2);
+    }
+
+    uint64_t tail = 0;
+    if (i < size) {
+        std::memcpy(&tail, data + i, size - i);
+    }
+    h = MulFold(tail ^ kSecret1, h ^ kSecret2);
+
+    return MulFold(h ^ size, kSecret2);
+}
+
+template <class K, class = void>
+struct Hash64 {
+    uint64_t operator()(const K& key) const {
+        return Mix64(static_cast<uint64_t>(std::hash<K>()(key)));
+    }
+};
+
+template <class K>
+struct Hash64<K, std::enable_if_t<std::is_integral_v<K> || std::is_enum_v<K>>> {
+    uint64_t operator()(K key) const {
+        return Mix64(static_cast<uint64_t>(key));
+    }
+};
+
+// transparent, so string-keyed maps can be probed with a string_view or const char*
+template <>
+struct Hash64<std::string> {
+    using is_transparent = void;
+
+    uint64_t operator()(std::string_view key) const {
+        return HashBytes(key.data(), key.size());
+    }
+};
+
+template <>
+struct Hash64<std::string_view> : Hash64<std::string> {
+};
+
+#endif //HASH64_H
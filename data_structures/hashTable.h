@@ -0,0 +1,476 @@
+#ifndef HASHTABLE_H
+#define HASHTABLE_H
+
+#include "hash64.h"
+
+#include <functional>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The key and value live in raw storage and exist only while the bucket is
+// occupied, so free buckets need neither a default-constructible K nor V.
+template <class K, class V>
+struct Bucket {
+    bool is_free_;
+    // how far the value sits from its home bucket
+    size_t dist_;
+
+    Bucket() : is_free_(true), dist_(0) {
+    }
+
+    template <class KeyArg, class... Args,
+              class = std::enable_if_t<!std::is_same_v<std::decay_t<KeyArg>, Bucket>>>
+    explicit Bucket(KeyArg&& key, Args&&... args) : Bucket() {
+        Emplace(std::forward<KeyArg>(key), std::forward<Args>(args)...);
+    }
+
+    Bucket(const Bucket& other) : Bucket() {
+        if (!other.is_free_) {
+            Emplace(other.Key(), other.Value());
+            dist_ = other.dist_;
+        }
+    }
+
+    Bucket(Bucket&& other) noexcept(std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>)
+            : Bucket() {
+        if (!other.is_free_) {
+            Emplace(std::move(other.Key()), std::move(other.Value()));
+            dist_ = other.dist_;
+        }
+    }
+
+    Bucket& operator=(const Bucket& other) {
+        if (this != &other) {
+            Clear();
+            if (!other.is_free_) {
+                Emplace(other.Key(), other.Value());
+                dist_ = other.dist_;
+            }
+        }
+        return *this;
+    }
+
+    Bucket& operator=(Bucket&& other) noexcept(std::is_nothrow_move_constructible_v<K>
+                                               && std::is_nothrow_move_constructible_v<V>) {
+        if (this != &other) {
+            Clear();
+            if (!other.is_free_) {
+                Emplace(std::move(other.Key()), std::move(other.Value()));
+                dist_ = other.dist_;
+            }
+        }
+        return *this;
+    }
+
+    ~Bucket() {
+        Clear();
+    }
+
+    // the bucket must be free
+    template <class KeyArg, class... Args>
+    void Emplace(KeyArg&& key, Args&&... args) {
+        new (key_) K(std::forward<KeyArg>(key));
+        try {
+            new (value_) V(std::forward<Args>(args)...);
+        } catch (...) {
+            Key().~K();
+            throw;
+        }
+        is_free_ = false;
+    }
+
+    void Clear() {
+        if (!is_free_) {
+            Key().~K();
+            Value().~V();
+            is_free_ = true;
+        }
+        dist_ = 0;
+    }
+
+    K& Key() {
+        return *std::launder(reinterpret_cast<K*>(key_));
+    }
+
+    const K& Key() const {
+        return *std::launder(reinterpret_cast<const K*>(key_));
+    }
+
+    V& Value() {
+        return *std::launder(reinterpret_cast<V*>(value_));
+    }
+
+    const V& Value() const {
+        return *std::launder(reinterpret_cast<const V*>(value_));
+    }
+
+private:
+    alignas(K) unsigned char key_[sizeof(K)];
+    alignas(V) unsigned char value_[sizeof(V)];
+};
+
+// Robin Hood linear probing: a value may evict a resident that is closer
+// to its home bucket, which keeps probe lengths even and lets Delete shift
+// the cluster back instead of leaving a tombstone. Growing is incremental:
+// the old table is drained a few buckets per modification while lookups
+// consult both tables.
+//
+// When both Hash and KeyEqual declare is_transparent, lookups accept any
+// type they can handle, e.g. std::string_view or const char* for
+// std::string keys, without building a temporary key.
+// Because values move around on insertion, returned pointers only live
+// until the next change.
+template <class T, class = void>
+struct IsTransparent : std::false_type {
+};
+
+template <class T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type {
+};
+
+template <class K, class V, class Hash = Hash64<K>, class KeyEqual = std::equal_to<>>
+class HashMap {
+    using BucketType = Bucket<K, V>;
+    using Table = std::vector<BucketType>;
+
+    template <class Q>
+    using EnableLookup = std::enable_if_t<
+            !std::is_same_v<std::decay_t<Q>, K> && IsTransparent<Hash>::value && IsTransparent<KeyEqual>::value>;
+
+    // the key is built from Q only if it turns out to be absent
+    template <class Q>
+    using EnableEmplace = std::enable_if_t<!std::is_same_v<std::decay_t<Q>, K> && IsTransparent<Hash>::value
+                                           && IsTransparent<KeyEqual>::value && std::is_constructible_v<K, Q&&>>;
+
+public:
+    HashMap() : HashMap(true) {
+    }
+
+    explicit HashMap(bool incremental_rehash)
+            : non_empty_(0), map_(8), migrate_pos_(0), incremental_(incremental_rehash) {
+    }
+
+    HashMap(const HashMap& other) = default;
+
+    HashMap(HashMap&& other) noexcept = default;
+
+    HashMap& operator=(const HashMap& other) = default;
+
+    HashMap& operator=(HashMap&& other) noexcept = default;
+
+    ~HashMap() = default;
+
+    long double GetLoadFactor() const {
+        return static_cast<long double>(non_empty_) / static_cast<long double>(map_.size());
+    }
+
+    // starts growing into a table twice the size; in incremental mode the
+    // values are moved over by the following operations
+    void Rehash() {
+        FinishRehash();
+        old_ = std::move(map_);
+        map_ = Table(old_.size() * 2);
+        migrate_pos_ = 0;
+        if (!incremental_) {
+            FinishRehash();
+        }
+    }
+
+    void FinishRehash() {
+        while (Rehashing()) {
+            MigrateStep();
+        }
+    }
+
+    bool Rehashing() const {
+        return !old_.empty();
+    }
+
+    V* Find(const K& key) {
+        return FindValue(key);
+    }
+
+    const V* Find(const K& key) const {
+        return const_cast<HashMap*>(this)->FindValue(key);
+    }
+
+    template <class Q, class = EnableLookup<Q>>
+    V* Find(const Q& key) {
+        return FindValue(key);
+    }
+
+    template <class Q, class = EnableLookup<Q>>
+    const V* Find(const Q& key) const {
+        return const_cast<HashMap*>(this)->FindValue(key);
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != nullptr;
+    }
+
+    template <class Q, class = EnableLookup<Q>>
+    bool Contains(const Q& key) const {
+        return Find(key) != nullptr;
+    }
+
+    // builds the value from args only if key is absent
+    template <class... Args>
+    std::pair<V*, bool> TryEmplace(const K& key, Args&&... args) {
+        return TryEmplaceImpl(key, hasher_(key), std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    std::pair<V*, bool> TryEmplace(K&& key, Args&&... args) {
+        const uint64_t hash = hasher_(key);
+        return TryEmplaceImpl(std::move(key), hash, std::forward<Args>(args)...);
+    }
+
+    template <class Q, class... Args, class = EnableEmplace<Q>>
+    std::pair<V*, bool> TryEmplace(Q&& key, Args&&... args) {
+        const uint64_t hash = hasher_(key);
+        return TryEmplaceImpl(std::forward<Q>(key), hash, std::forward<Args>(args)...);
+    }
+
+    template <class M>
+    std::pair<V*, bool> InsertOrAssign(const K& key, M&& value) {
+        return InsertOrAssignImpl(key, hasher_(key), std::forward<M>(value));
+    }
+
+    template <class M>
+    std::pair<V*, bool> InsertOrAssign(K&& key, M&& value) {
+        const uint64_t hash = hasher_(key);
+        return InsertOrAssignImpl(std::move(key), hash, std::forward<M>(value));
+    }
+
+    template <class Q, class M, class = EnableEmplace<Q>>
+    std::pair<V*, bool> InsertOrAssign(Q&& key, M&& value) {
+        const uint64_t hash = hasher_(key);
+        return InsertOrAssignImpl(std::forward<Q>(key), hash, std::forward<M>(value));
+    }
+
+    bool Add(const K& key, V value = V()) {
+        return TryEmplace(key, std::move(value)).second;
+    }
+
+    V* Search(const K& key) {
+        return Find(key);
+    }
+
+    template <class Q, class = EnableLookup<Q>>
+    V* Search(const Q& key) {
+        return Find(key);
+    }
+
+    bool Delete(const K& key) {
+        return DeleteImpl(key, hasher_(key));
+    }
+
+    template <class Q, class = EnableLookup<Q>>
+    bool Delete(const Q& key) {
+        return DeleteImpl(key, hasher_(key));
+    }
+
+    // For callers that hashed the key already, e.g. a sharded map that used
+    // the hash to pick this map; hash must be what Hash gives for key.
+    template <class Q>
+    V* FindWithHash(const Q& key, uint64_t hash) {
+        return FindValue(key, hash);
+    }
+
+    template <class Q>
+    const V* FindWithHash(const Q& key, uint64_t hash) const {
+        return const_cast<HashMap*>(this)->FindValue(key, hash);
+    }
+
+    template <class KeyArg, class... Args>
+    std::pair<V*, bool> TryEmplaceWithHash(KeyArg&& key, uint64_t hash, Args&&... args) {
+        return TryEmplaceImpl(std::forward<KeyArg>(key), hash, std::forward<Args>(args)...);
+    }
+
+    template <class KeyArg, class M>
+    std::pair<V*, bool> InsertOrAssignWithHash(KeyArg&& key, uint64_t hash, M&& value) {
+        return InsertOrAssignImpl(std::forward<KeyArg>(key), hash, std::forward<M>(value));
+    }
+
+    template <class Q>
+    bool DeleteWithHash(const Q& key, uint64_t hash) {
+        return DeleteImpl(key, hash);
+    }
+
+    // number of stored values
+    size_t Count() const {
+        return non_empty_;
+    }
+
+    // number of buckets in the current table
+    size_t Size() const {
+        return map_.size();
+    }
+
+protected:
+    size_t non_empty_;
+    Table map_;
+    // table being drained during an incremental rehash, empty otherwise
+    Table old_;
+    size_t migrate_pos_;
+    bool incremental_;
+    Hash hasher_;
+    KeyEqual equal_;
+
+private:
+    // with 4 buckets per operation the old table is empty well before the
+    // new one, which starts at 3/8 load, can reach 3/4 again
+    static const size_t kMigrateBatch = 4;
+
+    static size_t Home(const Table& table, uint64_t hash) {
+        return static_cast<size_t>(hash) & (table.size() - 1);
+    }
+
+    template <class Q>
+    size_t FindIn(const Table& table, const Q& key, uint64_t hash) const {
+        const size_t mask = table.size() - 1;
+        size_t idx = Home(table, hash);
+
+        for (size_t dist = 0; dist < table.size(); ++dist) {
+            // a poorer resident means our value would have evicted it
+            if (table[idx].is_free_ || table[idx].dist_ < dist) {
+                return table.size();
+            } else if (equal_(table[idx].Key(), key)) {
+                return idx;
+            }
+
+            idx = (idx + 1) & mask;
+        }
+
+        return table.size();
+    }
+
+    template <class Q>
+    V* FindValue(const Q& key) {
+        return FindValue(key, hasher_(key));
+    }
+
+    template <class Q>
+    V* FindValue(const Q& key, uint64_t hash) {
+        size_t idx = FindIn(map_, key, hash);
+        if (idx != map_.size()) {
+            return &map_[idx].Value();
+        }
+        if (Rehashing()) {
+            idx = FindIn(old_, key, hash);
+            if (idx != old_.size()) {
+                return &old_[idx].Value();
+            }
+        }
+        return nullptr;
+    }
+
+    // args are left untouched when the key is already present
+    template <class KeyArg, class... Args>
+    std::pair<V*, bool> TryEmplaceImpl(KeyArg&& key, uint64_t hash, Args&&... args) {
+        MigrateSome();
+        if (V* found = FindValue(key, hash)) {
+            return {found, false};
+        }
+
+        // grow first, so the returned pointer is not invalidated by the move
+        if (!Rehashing() && static_cast<long double>(non_empty_ + 1) / map_.size() >= 0.75) {
+            Rehash();
+        }
+
+        BucketType* placed = Insert(map_, BucketType(std::forward<KeyArg>(key), std::forward<Args>(args)...), hash);
+        ++non_empty_;
+        return {&placed->Value(), true};
+    }
+
+    // one probe: a present key leaves value unmoved, so it can still be assigned
+    template <class KeyArg, class M>
+    std::pair<V*, bool> InsertOrAssignImpl(KeyArg&& key, uint64_t hash, M&& value) {
+        std::pair<V*, bool> result = TryEmplaceImpl(std::forward<KeyArg>(key), hash, std::forward<M>(value));
+        if (!result.second) {
+            *result.first = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    template <class Q>
+    bool DeleteImpl(const Q& key, uint64_t hash) {
+        MigrateSome();
+        size_t idx = FindIn(map_, key, hash);
+        if (idx != map_.size()) {
+            Erase(map_, idx);
+        } else if (Rehashing() && (idx = FindIn(old_, key, hash)) != old_.size()) {
+            Erase(old_, idx);
+        } else {
+            return false;
+        }
+
+        --non_empty_;
+        return true;
+    }
+
+    // returns where the new value ended up; it may have displaced others
+    static BucketType* Insert(Table& table, BucketType&& item, uint64_t hash) {
+        const size_t mask = table.size() - 1;
+        size_t idx = Home(table, hash);
+        BucketType* placed = nullptr;
+        item.dist_ = 0;
+
+        while (!table[idx].is_free_) {
+            if (table[idx].dist_ < item.dist_) {
+                std::swap(table[idx], item);
+                if (placed == nullptr) {
+                    placed = &table[idx];
+                }
+            }
+
+            idx = (idx + 1) & mask;
+            ++item.dist_;
+        }
+
+        table[idx] = std::move(item);
+        return placed == nullptr ? &table[idx] : placed;
+    }
+
+    // backward shift: pull the rest of the cluster one step closer to home
+    static void Erase(Table& table, size_t idx) {
+        const size_t mask = table.size() - 1;
+        size_t next = (idx + 1) & mask;
+
+        while (!table[next].is_free_ && table[next].dist_ > 0) {
+            table[idx] = std::move(table[next]);
+            --table[idx].dist_;
+            idx = next;
+            next = (next + 1) & mask;
+        }
+
+        table[idx].Clear();
+    }
+
+    void MigrateSome() {
+        for (size_t i = 0; i < kMigrateBatch && Rehashing(); ++i) {
+            MigrateStep();
+        }
+    }
+
+    // Erasing from the old table only ever shifts values into buckets at or
+    // after migrate_pos_ (or, wrapping around, into its last bucket), so every
+    // bucket before migrate_pos_ stays free and nothing is skipped.
+    void MigrateStep() {
+        if (migrate_pos_ == old_.size()) {
+            old_ = Table();
+            migrate_pos_ = 0;
+        } else if (old_[migrate_pos_].is_free_) {
+            ++migrate_pos_;
+        } else {
+            const uint64_t hash = hasher_(old_[migrate_pos_].Key());
+            Insert(map_, std::move(old_[migrate_pos_]), hash);
+            Erase(old_, migrate_pos_);
+        }
+    }
+};
+
+#endif //HASHTABLE_H
@@ -0,0 +1,383 @@
+#ifndef LIST_H
+#define LIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+struct ListNodeBase {
+    ListNodeBase* prev_;
+    ListNodeBase* next_;
+};
+
+template <typename T>
+struct ListNode : ListNodeBase {
+    T value_;
+
+    template <class... Args>
+    explicit ListNode(Args&&... args) : ListNodeBase{nullptr, nullptr}, value_(std::forward<Args>(args)...) {
+    }
+
+    ListNode(const ListNode& other) = delete;
+
+    ListNode& operator=(const ListNode& other) = delete;
+
+    ~ListNode() = default;
+};
+
+// Doubly linked list around a sentinel node kept inside the list object,
+// so that begin() and end() need no special cases. Nodes are allocated one
+// at a time so that splice can hand them to another list in O(1); lists
+// that exchange nodes must use equal allocators.
+template <typename T, class Allocator = std::allocator<T>>
+class List {
+    using NodeAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<ListNode<T>>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() = default;
+
+        Iterator(ListNodeBase* ptr) : it_(ptr) {
+        }
+
+        Iterator& operator++() {
+            it_ = it_->next_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            it_ = it_->next_;
+            return tmp;
+        }
+
+        Iterator& operator--() {
+            it_ = it_->prev_;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator tmp = *this;
+            it_ = it_->prev_;
+            return tmp;
+        }
+
+        T& operator*() const {
+            return static_cast<ListNode<T>*>(it_)->value_;
+        }
+
+        T* operator->() const {
+            return &static_cast<ListNode<T>*>(it_)->value_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return it_ != other.it_;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return it_ == other.it_;
+        }
+
+    private:
+        friend class List;
+
+        ListNodeBase* it_;
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    List() : List(Allocator()) {
+    }
+
+    explicit List(const Allocator& alloc) : alloc_(alloc), size_(0), sentinel_{&sentinel_, &sentinel_} {
+    }
+
+    List(const size_t size, const T& value, const Allocator& alloc = Allocator()) : List(alloc) {
+        for (size_t i = 0; i < size; ++i) {
+            push_back(value);
+        }
+    }
+
+    List(std::initializer_list<T> i_list, const Allocator& alloc = Allocator()) : List(i_list.begin(), i_list.end(), alloc) {
+    }
+
+    template <class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+    List(InputIt first, InputIt last, const Allocator& alloc = Allocator()) : List(alloc) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    List(const List& other) : List(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        for (const_iterator it = other.cbegin(); it != other.cend(); ++it) {
+            push_back(*it);
+        }
+    }
+
+    List& operator=(const List& other) {
+        List(other).Swap(*this);
+        return *this;
+    }
+
+    List(List&& other) noexcept : List(other.alloc_) {
+        Swap(other);
+    }
+
+    List& operator=(List&& other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    // iterative, so that long lists do not exhaust the stack
+    ~List() {
+        clear();
+    }
+
+    iterator begin() {
+        return iterator(sentinel_.next_);
+    }
+
+    iterator end() {
+        return iterator(&sentinel_);
+    }
+
+    const_iterator cbegin() const {
+        return iterator(sentinel_.next_);
+    }
+
+    const_iterator cend() const {
+        return iterator(const_cast<ListNodeBase*>(&sentinel_));
+    }
+
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    template <class... Args>
+    T& emplace_front(Args&&... args) {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+
+    void pop_front() {
+        if (size_ != 0) {
+            erase(begin());
+        }
+    }
+
+    void pop_back() {
+        if (size_ != 0) {
+            erase(iterator(sentinel_.prev_));
+        }
+    }
+
+    // builds the value right before pos
+    template <class... Args>
+    iterator emplace(iterator pos, Args&&... args) {
+        ListNode<T>* node = CreateNode(std::forward<Args>(args)...);
+        Link(pos.it_, node);
+        ++size_;
+        return iterator(node);
+    }
+
+    iterator insert(iterator pos, const T& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(iterator pos, T&& value) {
+        return emplace(pos, std::move(value));
+    }
+
+    // returns the element after the erased one
+    iterator erase(iterator pos) {
+        ListNodeBase* next = pos.it_->next_;
+        Unlink(pos.it_, pos.it_);
+        DestroyNode(static_cast<ListNode<T>*>(pos.it_));
+        --size_;
+        return iterator(next);
+    }
+
+    iterator erase(iterator first, iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return last;
+    }
+
+    // moves all nodes of other before pos
+    void splice(iterator pos, List& other) {
+        if (&other == this || other.size_ == 0) {
+            return;
+        }
+        SpliceNodes(pos, other, other.begin(), other.end(), other.size_);
+    }
+
+    // moves the node at it from other before pos
+    void splice(iterator pos, List& other, iterator it) {
+        if (pos == it || pos.it_ == it.it_->next_) {
+            return;
+        }
+        iterator last = it;
+        SpliceNodes(pos, other, it, ++last, 1);
+    }
+
+    // moves [first, last) from other before pos; the nodes are counted
+    // unless they stay within this list, as with std::list
+    void splice(iterator pos, List& other, iterator first, iterator last) {
+        if (first == last) {
+            return;
+        }
+        const size_t count = &other == this ? 0 : static_cast<size_t>(std::distance(first, last));
+        SpliceNodes(pos, other, first, last, count);
+    }
+
+    void reverse() {
+        ListNodeBase* node = &sentinel_;
+        do {
+            std::swap(node->prev_, node->next_);
+            node = node->prev_;
+        } while (node != &sentinel_);
+    }
+
+    void clear() {
+        ListNodeBase* node = sentinel_.next_;
+        while (node != &sentinel_) {
+            ListNodeBase* next = node->next_;
+            DestroyNode(static_cast<ListNode<T>*>(node));
+            node = next;
+        }
+        sentinel_.prev_ = &sentinel_;
+        sentinel_.next_ = &sentinel_;
+        size_ = 0;
+    }
+
+    T& front() {
+        return *begin();
+    }
+
+    const T& front() const {
+        return *cbegin();
+    }
+
+    T& back() {
+        return static_cast<ListNode<T>*>(sentinel_.prev_)->value_;
+    }
+
+    const T& back() const {
+        return static_cast<const ListNode<T>*>(sentinel_.prev_)->value_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(alloc_);
+    }
+
+private:
+    NodeAlloc alloc_;
+    size_t size_;
+    ListNodeBase sentinel_;
+
+    void Swap(List& other) {
+        std::swap(alloc_, other.alloc_);
+        std::swap(size_, other.size_);
+        std::swap(sentinel_.prev_, other.sentinel_.prev_);
+        std::swap(sentinel_.next_, other.sentinel_.next_);
+        RelinkSentinel();
+        other.RelinkSentinel();
+    }
+
+    // the neighbours of a swapped sentinel still point to the old one
+    void RelinkSentinel() {
+        if (size_ == 0) {
+            sentinel_.prev_ = &sentinel_;
+            sentinel_.next_ = &sentinel_;
+        } else {
+            sentinel_.next_->prev_ = &sentinel_;
+            sentinel_.prev_->next_ = &sentinel_;
+        }
+    }
+
+    // puts node right before pos
+    static void Link(ListNodeBase* pos, ListNodeBase* node) {
+        node->prev_ = pos->prev_;
+        node->next_ = pos;
+        pos->prev_->next_ = node;
+        pos->prev_ = node;
+    }
+
+    // detaches the chain first..last, both inclusive
+    static void Unlink(ListNodeBase* first, ListNodeBase* last) {
+        first->prev_->next_ = last->next_;
+        last->next_->prev_ = first->prev_;
+    }
+
+    void SpliceNodes(iterator pos, List& other, iterator first, iterator last, size_t count) {
+        ListNodeBase* tail = last.it_->prev_;
+        Unlink(first.it_, tail);
+
+        first.it_->prev_ = pos.it_->prev_;
+        tail->next_ = pos.it_;
+        pos.it_->prev_->next_ = first.it_;
+        pos.it_->prev_ = tail;
+
+        other.size_ -= count;
+        size_ += count;
+    }
+
+    template <class... Args>
+    ListNode<T>* CreateNode(Args&&... args) {
+        ListNode<T>* node = NodeTraits::allocate(alloc_, 1);
+        try {
+            NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+        } catch (...) {
+            NodeTraits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    void DestroyNode(ListNode<T>* node) {
+        NodeTraits::destroy(alloc_, node);
+        NodeTraits::deallocate(alloc_, node, 1);
+    }
+};
+
+#endif //LIST_H
@@ -0,0 +1,39 @@
+#ifndef LOCKEDSHARD_H
+#define LOCKEDSHARD_H
+
+#include <cstddef>
+#include <cstdint>
+
+constexpr size_t kCacheLineSize = 64;
+
+// One part of a structure split into independently locked parts, so that
+// threads working on different parts rarely wait for each other. Every
+// shard starts a cache line of its own: two locks sharing a line would
+// still bounce it between the cores taking them, even though the locks
+// themselves are never contended (false sharing).
+template <class Lock, class Data>
+struct alignas(kCacheLineSize) LockedShard {
+    mutable Lock mutex_;
+    Data data_;
+};
+
+// log2 of shard_count rounded up to a power of two
+inline size_t ShardBits(size_t shard_count) {
+    size_t bits = 0;
+    while ((size_t(1) << bits) < shard_count) {
+        ++bits;
+    }
+    return bits;
+}
+
+// Shards are picked by the top bits of the hash. The tables inside a shard
+// index by the low bits, so the two choices stay uncorrelated and every
+// shard's table sees the full spread of its keys.
+inline size_t ShardOfHash(uint64_t hash, size_t shard_bits) {
+    if (shard_bits == 0) {
+        return 0;
+    }
+    return static_cast<size_t>(hash >> (64 - shard_bits));
+}
+
+#endif //LOCKEDSHARD_H
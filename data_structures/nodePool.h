@@ -0,0 +1,102 @@
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Node storage of a single container. Nodes are carved out of slabs taken
+// from the container's allocator, each slab twice as large as the previous
+// one up to kMaxSlabNodes. Freed nodes go to a free list and are handed out
+// again; the slabs go back to the allocator only on Release, all at once.
+// The first node-sized block of every slab links the slabs together.
+template <class Node, class NodeAlloc>
+class NodePool {
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+
+public:
+    NodePool() noexcept : slabs_(nullptr), free_(nullptr), current_(nullptr), end_(nullptr), next_slab_nodes_(kMinSlabNodes) {
+    }
+
+    NodePool(const NodePool& other) = delete;
+
+    NodePool& operator=(const NodePool& other) = delete;
+
+    // the owner has to call Release with its allocator
+    ~NodePool() = default;
+
+    // raw storage for one node, the caller constructs it
+    Node* Allocate(NodeAlloc& alloc) {
+        if (free_ != nullptr) {
+            FreeBlock* block = free_;
+            free_ = block->next_;
+            return reinterpret_cast<Node*>(block);
+        }
+        if (current_ == end_) {
+            NewSlab(alloc);
+        }
+        return current_++;
+    }
+
+    // takes back the storage of a node that was already destroyed
+    void Deallocate(Node* node) noexcept {
+        free_ = new (node) FreeBlock{free_};
+    }
+
+    void Release(NodeAlloc& alloc) noexcept {
+        while (slabs_ != nullptr) {
+            SlabHeader* next = slabs_->next_;
+            const size_t nodes = slabs_->nodes_;
+            NodeTraits::deallocate(alloc, reinterpret_cast<Node*>(slabs_), nodes);
+            slabs_ = next;
+        }
+        free_ = nullptr;
+        current_ = nullptr;
+        end_ = nullptr;
+        next_slab_nodes_ = kMinSlabNodes;
+    }
+
+    void Swap(NodePool& other) noexcept {
+        std::swap(slabs_, other.slabs_);
+        std::swap(free_, other.free_);
+        std::swap(current_, other.current_);
+        std::swap(end_, other.end_);
+        std::swap(next_slab_nodes_, other.next_slab_nodes_);
+    }
+
+private:
+    struct SlabHeader {
+        SlabHeader* next_;
+        size_t nodes_;
+    };
+
+    struct FreeBlock {
+        FreeBlock* next_;
+    };
+
+    static_assert(sizeof(Node) >= sizeof(SlabHeader), "a node must be able to hold a slab header");
+
+    static const size_t kMinSlabNodes = 16;
+    static const size_t kMaxSlabNodes = 8192;
+
+    SlabHeader* slabs_;
+    FreeBlock* free_;
+    // untouched part of the newest slab
+    Node* current_;
+    Node* end_;
+    size_t next_slab_nodes_;
+
+    void NewSlab(NodeAlloc& alloc) {
+        const size_t nodes = next_slab_nodes_;
+        Node* slab = NodeTraits::allocate(alloc, nodes);
+        slabs_ = new (slab) SlabHeader{slabs_, nodes};
+        current_ = slab + 1;
+        end_ = slab + nodes;
+        if (next_slab_nodes_ < kMaxSlabNodes) {
+            next_slab_nodes_ *= 2;
+        }
+    }
+};
+
+#endif //NODEPOOL_H
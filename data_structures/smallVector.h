@@ -0,0 +1,377 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Vector with the same interface that keeps up to N elements inline
+// and only goes to the heap once it outgrows them.
+template <class T, size_t N = 8>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline slot");
+
+public:
+    SmallVector() : buffer_(InlineBuffer()), size_(0), capacity_(N) {
+    }
+
+    explicit SmallVector(size_t size) : SmallVector() {
+        Resize(size);
+    }
+
+    SmallVector(size_t size, const T& value) : SmallVector() {
+        Resize(size, value);
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        Reserve(other.size_);
+        std::allocator<T> alloc;
+        CopyBuffers(alloc, other.buffer_, buffer_, other.size_);
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+        MoveFrom(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            Clear();
+            Reserve(other.size_);
+            std::allocator<T> alloc;
+            CopyBuffers(alloc, other.buffer_, buffer_, other.size_);
+            size_ = other.size_;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            Clear();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        std::allocator<T> alloc;
+        DestroyRange(alloc, buffer_, buffer_ + size_);
+        Deallocate(buffer_);
+    }
+
+    void Clear() {
+        std::allocator<T> alloc;
+        DestroyRange(alloc, buffer_, buffer_ + size_);
+        size_ = 0;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <class... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ < capacity_) {
+            new (buffer_ + size_) T(std::forward<Args>(args)...);
+        } else {
+            // built first so that args may still refer to our own elements
+            const size_t new_capacity = kIncreasefactor * capacity_;
+            T* tmpBuffer = Allocate(new_capacity);
+            try {
+                new (tmpBuffer + size_) T(std::forward<Args>(args)...);
+            } catch (...) {
+                Deallocate(tmpBuffer);
+                throw;
+            }
+            std::allocator<T> alloc;
+            try {
+                RelocateBuffers(alloc, buffer_, tmpBuffer, size_);
+            } catch (...) {
+                tmpBuffer[size_].~T();
+                Deallocate(tmpBuffer);
+                throw;
+            }
+            DestroyRange(alloc, buffer_, buffer_ + size_);
+            Deallocate(buffer_);
+            buffer_ = tmpBuffer;
+            capacity_ = new_capacity;
+        }
+        return buffer_[size_++];
+    }
+
+    // appends [first, last); the range must not point into this vector
+    template <class InputIt>
+    void Append(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            const size_t count = std::distance(first, last);
+            if (size_ + count > capacity_) {
+                Reallocate(std::max(size_ + count, kIncreasefactor * capacity_));
+            }
+            size_t built = 0;
+            try {
+                for (; built < count; ++built, ++first) {
+                    new (buffer_ + size_ + built) T(*first);
+                }
+            } catch (...) {
+                std::allocator<T> alloc;
+                DestroyRange(alloc, buffer_ + size_, buffer_ + size_ + built);
+                throw;
+            }
+            size_ += count;
+        } else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    // inserts [first, last) before the element at index pos;
+    // the range must not point into this vector
+    template <class InputIt>
+    void Insert(size_t pos, InputIt first, InputIt last) {
+        const size_t old_size = size_;
+        Append(first, last);
+        std::rotate(buffer_ + pos, buffer_ + old_size, buffer_ + size_);
+    }
+
+    void PopBack() {
+        if (!Empty()) {
+            --size_;
+            buffer_[size_].~T();
+        }
+    }
+
+    void Resize(size_t new_size) {
+        std::allocator<T> alloc;
+        if (new_size > size_) {
+            Reserve(new_size);
+            ValueInit(alloc, new_size - size_, buffer_ + size_);
+        } else {
+            DestroyRange(alloc, buffer_ + new_size, buffer_ + size_);
+        }
+        size_ = new_size;
+    }
+
+    void Resize(size_t new_size, const T& value) {
+        std::allocator<T> alloc;
+        if (new_size > size_) {
+            if (new_size > capacity_) {
+                T tmp(value);
+                Reallocate(new_size);
+                FillWith(alloc, tmp, new_size - size_, buffer_ + size_);
+            } else {
+                FillWith(alloc, value, new_size - size_, buffer_ + size_);
+            }
+        } else {
+            DestroyRange(alloc, buffer_ + new_size, buffer_ + size_);
+        }
+        size_ = new_size;
+    }
+
+    void Reserve(size_t new_cap = 0) {
+        if (new_cap > capacity_) {
+            Reallocate(new_cap);
+        }
+    }
+
+    // moves the elements back inline when they fit there again
+    void ShrinkToFit() {
+        if (IsSmall() || capacity_ == size_) {
+            return;
+        }
+        if (size_ <= N) {
+            T* heapBuffer = buffer_;
+            std::allocator<T> alloc;
+            RelocateBuffers(alloc, heapBuffer, InlineBuffer(), size_);
+            DestroyRange(alloc, heapBuffer, heapBuffer + size_);
+            Deallocate(heapBuffer);
+            buffer_ = InlineBuffer();
+            capacity_ = N;
+        } else {
+            Reallocate(size_);
+        }
+    }
+
+    void Swap(SmallVector& other) {
+        if (!IsSmall() && !other.IsSmall()) {
+            SwapArgs(size_, other.size_);
+            SwapArgs(capacity_, other.capacity_);
+            SwapArgs(buffer_, other.buffer_);
+        } else {
+            SmallVector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+    }
+
+    T& operator[](size_t idx) {
+        return buffer_[idx];
+    }
+
+    T operator[](size_t idx) const {
+        return buffer_[idx];
+    }
+
+    T& Front() {
+        return buffer_[0];
+    }
+
+    T Front() const {
+        return buffer_[0];
+    }
+
+    T& Back() {
+        return buffer_[size_ - 1];
+    }
+
+    T Back() const {
+        return buffer_[size_ - 1];
+    }
+
+    bool Empty() const {
+        return size_ == 0;
+    }
+
+    size_t Size() const {
+        return size_;
+    }
+
+    size_t Capacity() const {
+        return capacity_;
+    }
+
+    // true while the elements live in the inline storage
+    bool IsSmall() const {
+        return buffer_ == InlineBuffer();
+    }
+
+    const T* Data() const {
+        return buffer_;
+    }
+
+    T* Data() {
+        return buffer_;
+    }
+
+private:
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+    T* buffer_;
+    size_t size_;
+    size_t capacity_;
+
+    static const size_t kIncreasefactor = 2;
+
+    T* InlineBuffer() {
+        return reinterpret_cast<T*>(storage_);
+    }
+
+    const T* InlineBuffer() const {
+        return reinterpret_cast<const T*>(storage_);
+    }
+
+    // plain operator new only guarantees the default new alignment
+    static T* Allocate(size_t capacity) {
+        return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void Deallocate(T* buffer) {
+        if (buffer != InlineBuffer()) {
+            ::operator delete(buffer, std::align_val_t(alignof(T)));
+        }
+    }
+
+    void Reallocate(size_t new_capacity) {
+        T* tmpBuffer = Allocate(new_capacity);
+        std::allocator<T> alloc;
+        try {
+            RelocateBuffers(alloc, buffer_, tmpBuffer, size_);
+        } catch (...) {
+            Deallocate(tmpBuffer);
+            throw;
+        }
+        DestroyRange(alloc, buffer_, buffer_ + size_);
+        Deallocate(buffer_);
+        buffer_ = tmpBuffer;
+        capacity_ = new_capacity;
+    }
+
+    // expects *this to be empty; steals a heap buffer, relocates inline elements
+    void MoveFrom(SmallVector& other) {
+        if (!other.IsSmall()) {
+            Deallocate(buffer_);
+            buffer_ = other.buffer_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            other.buffer_ = other.InlineBuffer();
+            other.capacity_ = N;
+            other.size_ = 0;
+        } else {
+            std::allocator<T> alloc;
+            RelocateBuffers(alloc, other.buffer_, buffer_, other.size_);
+            size_ = other.size_;
+            other.Clear();
+        }
+    }
+};
+
+template <class T, size_t N>
+static int Compare(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+    for (size_t i = 0; i < lhs.Size() && i < rhs.Size(); ++i) {
+        if (lhs[i] > rhs[i]) {
+            return 1;
+        } else if (lhs[i] < rhs[i]) {
+            return -1;
+        }
+    }
+
+    if (lhs.Size() > rhs.Size()) {
+        return 1;
+    } else if (lhs.Size() < rhs.Size()) {
+        return -1;
+    } else {
+        return 0;
+    }
+}
+
+template <class T, size_t N>
+bool operator==(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+    return Compare(lhs, rhs) == 0;
+}
+
+template <class T, size_t N>
+bool operator!=(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class T, size_t N>
+bool operator>(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+    return Compare(lhs, rhs) > 0;
+}
+
+template <class T, size_t N>
+bool operator<=(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <class T, size_t N>
+bool operator<(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+    return rhs > lhs;
+}
+
+template <class T, size_t N>
+bool operator>=(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs) {
+    return !(lhs < rhs);
+}
+
+#endif // SMALLVECTOR_H
@@ -0,0 +1,17 @@
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <cstdlib>
+#include <iostream>
+
+// Stops the test with the failed condition and its location. Unlike assert
+// it stays on in builds that define NDEBUG.
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            std::cerr << __FILE__ << ':' << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            std::exit(1);                                                                  \
+        }                                                                                  \
+    } while (false)
+
+#endif //TESTCHECK_H
@@ -0,0 +1,113 @@
+#include "allocators.h"
+#include "testCheck.h"
+#include "vector.h"
+
+#include <string>
+#include <thread>
+
+// counts the values it builds and destroys, so that Vector can be checked
+// to go through allocator_traits even for trivially copyable elements
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    static inline int constructed = 0;
+    static inline int destroyed = 0;
+
+    CountingAllocator() = default;
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>&) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) {
+        ::operator delete(ptr);
+    }
+
+    template <class U, class... Args>
+    void construct(U* ptr, Args&&... args) {
+        ++constructed;
+        new (ptr) U(std::forward<Args>(args)...);
+    }
+
+    template <class U>
+    void destroy(U* ptr) {
+        ++destroyed;
+        ptr->~U();
+    }
+};
+
+template <class T, class U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) {
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) {
+    return false;
+}
+
+void TestVectorConstructsThroughAllocator() {
+    using Alloc = CountingAllocator<int>;
+    {
+        Vector<int, Alloc> vector;
+        for (int i = 0; i < 10; ++i) {
+            vector.PushBack(i);
+        }
+        // 10 pushes plus the values relocated by 4 growths (1 + 2 + 4 + 8)
+        CHECK(Alloc::constructed == 10 + 15);
+        CHECK(Alloc::destroyed == 15);
+
+        Vector<int, Alloc> copy(vector);
+        CHECK(copy == vector);
+        vector.PopBack();
+        vector.Resize(12, 7);
+        CHECK(vector.Size() == 12 && vector[8] == 8 && vector[9] == 7);
+    }
+    CHECK(Alloc::constructed == Alloc::destroyed);
+}
+
+void TestVectorOnArena() {
+    Arena arena;
+    Vector<std::string, ArenaAllocator<std::string>> vector{ArenaAllocator<std::string>(&arena)};
+    for (int i = 0; i < 100; ++i) {
+        vector.EmplaceBack(std::to_string(i));
+    }
+    CHECK(vector.Size() == 100 && vector[42] == "42");
+    CHECK(vector.GetAllocator().Resource() == &arena);
+
+    Vector<std::string, ArenaAllocator<std::string>> moved(std::move(vector));
+    CHECK(moved.Size() == 100 && vector.Empty());
+    CHECK(moved.GetAllocator().Resource() == &arena);
+}
+
+void TestPoolAllocatorIsBoundToItsThread() {
+    PoolAllocator<int> here;
+    PoolAllocator<double> rebound(here);
+    CHECK(here == rebound);
+
+    PoolAllocator<int> there;
+    std::thread([&there]() { there = PoolAllocator<int>(); }).join();
+    CHECK(here != there);
+
+    Vector<int, PoolAllocator<int>> vector(here);
+    for (int i = 0; i < 1000; ++i) {
+        vector.PushBack(i);
+    }
+    CHECK(vector[999] == 999);
+    CHECK(vector.GetAllocator() == here);
+
+    Vector<int, PoolAllocator<int>> empty;
+    CHECK(empty.Size() == 0 && empty.Data() == nullptr);
+}
+
+int main() {
+    TestVectorConstructsThroughAllocator();
+    TestVectorOnArena();
+    TestPoolAllocatorIsBoundToItsThread();
+    return 0;
+}
@@ -0,0 +1,454 @@
+#include "compactStringMap.h"
+#include "concurrentHashMap.h"
+#include "flatHashMap.h"
+#include "hash64.h"
+#include "hashTable.h"
+#include "testCheck.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// keys shorter than one eight-byte block are hashed by the tail fold alone
+void TestShortKeysHashApart() {
+    std::unordered_set<uint64_t> hashes;
+    size_t keys = 0;
+    for (int a = 0; a < 256; ++a) {
+        const char key[] = {static_cast<char>(a)};
+        hashes.insert(HashBytes(key, 1));
+        ++keys;
+        for (int b = 0; b < 256; ++b) {
+            const char pair[] = {static_cast<char>(a), static_cast<char>(b)};
+            hashes.insert(HashBytes(pair, 2));
+            ++keys;
+        }
+    }
+
+    std::mt19937 generator(5);
+    for (size_t size = 3; size <= 7; ++size) {
+        std::unordered_set<std::string> seen;
+        while (seen.size() < 20000) {
+            std::string key(size, '\0');
+            for (char& c : key) {
+                c = static_cast<char>(generator());
+            }
+            if (seen.insert(key).second) {
+                hashes.insert(HashBytes(key.data(), key.size()));
+                ++keys;
+            }
+        }
+    }
+    CHECK(hashes.size() == keys);
+
+    // the empty key and keys of zero bytes still differ by length
+    CHECK(HashBytes("", 0) != HashBytes("\0", 1));
+    CHECK(HashBytes("\0", 1) != HashBytes("\0\0", 2));
+}
+
+void TestFlatHashMapEmpty() {
+    FlatHashMap<std::string, int> map;
+    CHECK(map.Empty() && map.Size() == 0 && map.Capacity() == 0);
+    CHECK(map.Search("missing") == nullptr);
+    CHECK(!map.Delete("missing"));
+    CHECK(map.GetLoadFactor() == 0);
+    map.Clear();
+    CHECK(map.Empty());
+
+    FlatHashMap<std::string, int> copy(map);
+    CHECK(copy.Empty());
+}
+
+// random churn against std::unordered_map, crossing every growth step and
+// leaving deleted slots behind
+void TestFlatHashMapMatchesStd() {
+    FlatHashMap<std::string, int> map;
+    std::unordered_map<std::string, int> expected;
+    std::mt19937 generator(7);
+    size_t last_capacity = 0;
+    size_t growths = 0;
+
+    for (int step = 0; step < 200000; ++step) {
+        const std::string key = "k" + std::to_string(generator() % 5000);
+        const unsigned op = generator() % 4;
+        if (op < 2) {
+            CHECK(map.Add(key, step) == expected.emplace(key, step).second);
+        } else if (op == 2) {
+            CHECK(map.Delete(key) == (expected.erase(key) == 1));
+        } else {
+            const int* found = map.Search(key);
+            auto it = expected.find(key);
+            CHECK((found == nullptr) == (it == expected.end()));
+            CHECK(found == nullptr || *found == it->second);
+        }
+        CHECK(map.Size() == expected.size());
+        CHECK(map.GetLoadFactor() <= 0.875);
+        if (map.Capacity() != last_capacity) {
+            last_capacity = map.Capacity();
+            ++growths;
+        }
+    }
+    CHECK(growths > 5);
+
+    size_t visited = 0;
+    map.ForEach([&](const std::string& key, int value) {
+        CHECK(expected.at(key) == value);
+        ++visited;
+    });
+    CHECK(visited == expected.size());
+
+    FlatHashMap<std::string, int> copy(map);
+    FlatHashMap<std::string, int> moved(std::move(map));
+    CHECK(map.Empty() && copy.Size() == expected.size() && moved.Size() == expected.size());
+    for (const auto& [key, value] : expected) {
+        CHECK(*copy.Search(key) == value && *moved.Search(key) == value);
+    }
+
+    moved.Clear();
+    CHECK(moved.Empty() && moved.Search(expected.begin()->first) == nullptr);
+    CHECK(moved.Add("again", 1) && *moved.Search("again") == 1);
+}
+
+void TestFlatHashMapReserve() {
+    FlatHashMap<int, int> map;
+    map.Reserve(1000);
+    const size_t capacity = map.Capacity();
+    CHECK(capacity >= 1000);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(map.Add(i, -i));
+    }
+    CHECK(map.Capacity() == capacity);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(*map.Search(i) == -i);
+    }
+    CHECK(map.Search(1000) == nullptr);
+}
+
+// churn against std::unordered_map in both growth modes; in incremental
+// mode many of the operations land while the old table is still draining
+void TestHashMapMatchesStd(bool incremental) {
+    HashMap<std::string, int> map(incremental);
+    std::unordered_map<std::string, int> expected;
+    std::mt19937 generator(11);
+    size_t ops_while_rehashing = 0;
+
+    for (int step = 0; step < 200000; ++step) {
+        const std::string key = std::to_string(generator() % 4000);
+        const unsigned op = generator() % 4;
+        ops_while_rehashing += map.Rehashing();
+        if (op < 2) {
+            CHECK(map.Add(key, step) == expected.emplace(key, step).second);
+        } else if (op == 2) {
+            CHECK(map.Delete(key) == (expected.erase(key) == 1));
+        } else {
+            const int* found = map.Search(key);
+            auto it = expected.find(key);
+            CHECK((found == nullptr) == (it == expected.end()));
+            CHECK(found == nullptr || *found == it->second);
+        }
+        CHECK(map.Count() == expected.size());
+        CHECK(!incremental || map.GetLoadFactor() < 1);
+        CHECK(incremental || !map.Rehashing());
+    }
+    CHECK(incremental == (ops_while_rehashing > 0));
+
+    for (const auto& [key, value] : expected) {
+        CHECK(map.Contains(key) && *map.Search(key) == value);
+    }
+    CHECK(!map.Contains("missing"));
+}
+
+// every value stays reachable at each step of a migration, including
+// values deleted and re-added while both tables are live
+void TestHashMapIncrementalRehash() {
+    HashMap<int, int> map;
+    for (int i = 0; i < 5; ++i) {
+        CHECK(map.Add(i, i));
+    }
+    const size_t old_size = map.Size();
+    map.Rehash();
+    CHECK(map.Rehashing() && map.Size() == 2 * old_size);
+
+    for (int i = 0; i < 5; ++i) {
+        CHECK(*map.Search(i) == i);
+    }
+    CHECK(map.Delete(0) && !map.Contains(0));
+    CHECK(map.Add(0, 100) && *map.Search(0) == 100);
+    CHECK(!map.Add(3, 300) && *map.Search(3) == 3);
+
+    map.FinishRehash();
+    CHECK(!map.Rehashing() && map.Count() == 5);
+    for (int i = 1; i < 5; ++i) {
+        CHECK(*map.Search(i) == i);
+    }
+    CHECK(*map.Search(0) == 100);
+
+    // a second Rehash finishes the first one before starting
+    map.Rehash();
+    map.Rehash();
+    map.FinishRehash();
+    CHECK(map.Size() == 8 * old_size && map.Count() == 5);
+}
+
+// Delete shifts the cluster back, so removing the head of a long cluster
+// must keep the values behind it reachable
+void TestHashMapBackwardShift() {
+    HashMap<int, int> map(false);
+    for (int i = 0; i < 6; ++i) {
+        CHECK(map.Add(i, i));
+    }
+    for (int round = 0; round < 6; ++round) {
+        CHECK(map.Delete(round));
+        for (int i = round + 1; i < 6; ++i) {
+            CHECK(*map.Search(i) == i);
+        }
+    }
+    CHECK(map.Count() == 0 && !map.Delete(0));
+}
+
+// counts live instances; deliberately has no default constructor
+struct Tracked {
+    static inline int alive = 0;
+    static inline int built_from_view = 0;
+
+    std::string name_;
+
+    explicit Tracked(std::string_view name) : name_(name) {
+        ++alive;
+        ++built_from_view;
+    }
+
+    Tracked(const Tracked& other) : name_(other.name_) {
+        ++alive;
+    }
+
+    Tracked(Tracked&& other) noexcept : name_(std::move(other.name_)) {
+        ++alive;
+    }
+
+    Tracked& operator=(const Tracked& other) = default;
+
+    Tracked& operator=(Tracked&& other) noexcept = default;
+
+    ~Tracked() {
+        --alive;
+    }
+};
+
+struct TrackedHash {
+    using is_transparent = void;
+
+    uint64_t operator()(std::string_view name) const {
+        return HashBytes(name.data(), name.size());
+    }
+
+    uint64_t operator()(const Tracked& key) const {
+        return (*this)(std::string_view(key.name_));
+    }
+};
+
+struct TrackedEqual {
+    using is_transparent = void;
+
+    static std::string_view View(const Tracked& key) {
+        return key.name_;
+    }
+
+    static std::string_view View(std::string_view name) {
+        return name;
+    }
+
+    template <class A, class B>
+    bool operator()(const A& lhs, const B& rhs) const {
+        return View(lhs) == View(rhs);
+    }
+};
+
+// free buckets hold no objects, so only stored keys and values are alive
+void TestHashMapBucketsAreRaw() {
+    {
+        HashMap<Tracked, Tracked, TrackedHash, TrackedEqual> map;
+        CHECK(Tracked::alive == 0);
+        for (int i = 0; i < 100; ++i) {
+            const std::string name = std::to_string(i);
+            CHECK(map.TryEmplace(Tracked(name), name + "!").second);
+        }
+        CHECK(Tracked::alive == 200);
+        CHECK(map.Find(std::string_view("42"))->name_ == "42!");
+
+        HashMap<Tracked, Tracked, TrackedHash, TrackedEqual> copy(map);
+        CHECK(Tracked::alive == 400);
+        for (int i = 0; i < 50; ++i) {
+            CHECK(copy.Delete(std::string_view(std::to_string(i))));
+        }
+        CHECK(Tracked::alive == 300 && copy.Count() == 50);
+        copy = map;
+        CHECK(Tracked::alive == 400 && copy.Count() == 100);
+    }
+    CHECK(Tracked::alive == 0);
+}
+
+void TestHashMapHeterogeneousEmplace() {
+    HashMap<Tracked, int, TrackedHash, TrackedEqual> map;
+    CHECK(map.TryEmplace(std::string_view("key"), 1).second);
+    const int built = Tracked::built_from_view;
+
+    // a present key is found without building a Tracked from the view
+    std::pair<int*, bool> again = map.TryEmplace(std::string_view("key"), 2);
+    CHECK(!again.second && *again.first == 1);
+    std::pair<int*, bool> assigned = map.InsertOrAssign(std::string_view("key"), 3);
+    CHECK(!assigned.second && *assigned.first == 3);
+    CHECK(Tracked::built_from_view == built);
+
+    CHECK(map.InsertOrAssign(std::string_view("other"), 4).second);
+    CHECK(Tracked::built_from_view == built + 1);
+    CHECK(*map.Find(std::string_view("other")) == 4 && map.Count() == 2);
+
+    HashMap<std::string, int> strings;
+    CHECK(strings.TryEmplace("literal", 5).second);
+    CHECK(!strings.TryEmplace("literal", 6).second && *strings.Find("literal") == 5);
+}
+
+// the value is moved only when it is used, so a present key can still take it
+void TestHashMapInsertOrAssign() {
+    HashMap<std::string, std::unique_ptr<int>> map;
+    std::pair<std::unique_ptr<int>*, bool> inserted = map.InsertOrAssign("a", std::make_unique<int>(1));
+    CHECK(inserted.second && **inserted.first == 1);
+
+    auto value = std::make_unique<int>(2);
+    std::pair<std::unique_ptr<int>*, bool> assigned = map.InsertOrAssign("a", std::move(value));
+    CHECK(!assigned.second && **assigned.first == 2 && value == nullptr);
+    CHECK(map.Count() == 1);
+
+    auto kept = std::make_unique<int>(3);
+    CHECK(!map.TryEmplace("a", std::move(kept)).second && kept != nullptr);
+}
+
+struct CountingHash {
+    static inline std::atomic<int> calls{0};
+
+    uint64_t operator()(int key) const {
+        ++calls;
+        return Mix64(static_cast<uint64_t>(key));
+    }
+};
+
+// the hash that picks the shard is reused by the shard's table
+void TestConcurrentHashMapHashesOnce() {
+    ConcurrentHashMap<int, int, CountingHash> map(8);
+    for (int i = 0; i < 8; ++i) {
+        CHECK(map.Add(i, i));
+    }
+    CountingHash::calls = 0;
+    CHECK(map.Contains(3));
+    CHECK(*map.Search(4) == 4);
+    CHECK(!map.Search(100).has_value());
+    CHECK(map.Visit(5, [](int& value) { value = 50; }));
+    CHECK(!map.InsertOrAssign(5, 51));
+    CHECK(map.Delete(6));
+    CHECK(CountingHash::calls == 6);
+    CHECK(*map.Search(5) == 51 && map.Count() == 7);
+}
+
+void TestConcurrentHashMapThreads() {
+    ConcurrentHashMap<int, int> map(16);
+    CHECK(map.ShardCount() == 16 && map.Count() == 0);
+    CHECK(!map.Search(0).has_value() && !map.Delete(0));
+
+    const int kThreads = 4;
+    const int kPerThread = 5000;
+    CHECK(map.Add(-1, 0));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&map, t]() {
+            for (int i = t * kPerThread; i < (t + 1) * kPerThread; ++i) {
+                CHECK(map.Add(i, i));
+                // every thread also bumps one shared counter
+                CHECK(map.Visit(-1, [](int& value) { ++value; }));
+            }
+            for (int i = t * kPerThread; i < (t + 1) * kPerThread; i += 2) {
+                CHECK(map.Delete(i));
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    CHECK(map.Count() == kThreads * kPerThread / 2 + 1);
+    CHECK(*map.Search(-1) == kThreads * kPerThread);
+    for (int i = 0; i < kThreads * kPerThread; ++i) {
+        CHECK(map.Contains(i) == (i % 2 == 1));
+    }
+}
+
+void TestCompactStringMapEdgeKeys() {
+    CompactStringMap<int> map;
+    CHECK(map.Count() == 0 && map.Find("") == nullptr && !map.Delete(""));
+
+    CHECK(map.Add("", 1) && !map.Add("", 2) && *map.Find("") == 1);
+    const std::string with_nul("a\0b", 3);
+    CHECK(map.Add(with_nul, 3) && map.Find("a") == nullptr && *map.Find(with_nul) == 3);
+    const std::string long_key(10000, 'x');
+    CHECK(map.Add(long_key, 4) && *map.Find(long_key) == 4);
+    CHECK(map.Find(std::string(9999, 'x')) == nullptr);
+
+    CHECK(map.Delete("") && !map.Contains("") && map.Count() == 2);
+}
+
+// the arena is compacted once deleted keys outweigh live ones; keys must
+// stay findable across every compaction and growth
+void TestCompactStringMapMatchesStd() {
+    CompactStringMap<int> map;
+    std::unordered_map<std::string, int> expected;
+    std::mt19937 generator(13);
+
+    for (int step = 0; step < 100000; ++step) {
+        const std::string key = "key/" + std::to_string(generator() % 3000) + std::string(generator() % 20, 'p');
+        if (generator() % 3 != 0) {
+            CHECK(map.Add(key, step) == expected.emplace(key, step).second);
+        } else {
+            CHECK(map.Delete(key) == (expected.erase(key) == 1));
+        }
+        CHECK(map.Count() == expected.size());
+    }
+
+    size_t visited = 0;
+    map.ForEach([&](std::string_view key, int value) {
+        CHECK(expected.at(std::string(key)) == value);
+        ++visited;
+    });
+    CHECK(visited == expected.size());
+
+    const size_t before = map.MemoryUsage();
+    for (const auto& entry : expected) {
+        CHECK(map.Delete(entry.first));
+    }
+    CHECK(map.Count() == 0 && map.MemoryUsage() <= before);
+    CHECK(map.Add("fresh", 1) && *map.Find("fresh") == 1);
+}
+
+int main() {
+    TestShortKeysHashApart();
+    TestFlatHashMapEmpty();
+    TestFlatHashMapMatchesStd();
+    TestFlatHashMapReserve();
+    TestHashMapMatchesStd(true);
+    TestHashMapMatchesStd(false);
+    TestHashMapIncrementalRehash();
+    TestHashMapBackwardShift();
+    TestHashMapBucketsAreRaw();
+    TestHashMapHeterogeneousEmplace();
+    TestHashMapInsertOrAssign();
+    TestConcurrentHashMapHashesOnce();
+    TestConcurrentHashMapThreads();
+    TestCompactStringMapEdgeKeys();
+    TestCompactStringMapMatchesStd();
+    return 0;
+}
@@ -0,0 +1,350 @@
+#include "forwardList.h"
+#include "list.h"
+#include "testCheck.h"
+#include "unrolledForwardList.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// counts the calls reaching the underlying allocator
+template <class T>
+struct SlabCountingAllocator {
+    using value_type = T;
+
+    size_t* allocations_;
+
+    explicit SlabCountingAllocator(size_t* allocations) : allocations_(allocations) {
+    }
+
+    template <class U>
+    SlabCountingAllocator(const SlabCountingAllocator<U>& other) : allocations_(other.allocations_) {
+    }
+
+    T* allocate(const size_t n) {
+        ++*allocations_;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, const size_t n) {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <class U>
+    bool operator==(const SlabCountingAllocator<U>& other) const {
+        return allocations_ == other.allocations_;
+    }
+
+    template <class U>
+    bool operator!=(const SlabCountingAllocator<U>& other) const {
+        return !(*this == other);
+    }
+};
+
+template <class Container>
+std::vector<int> Collect(Container& container) {
+    std::vector<int> result;
+    for (auto it = container.begin(); it != container.end(); ++it) {
+        result.push_back(*it);
+    }
+    return result;
+}
+
+void TestForwardListEmpty() {
+    ForwardList<int> list;
+    CHECK(list.size() == 0 && list.begin() == list.end());
+    list.pop_front();
+    list.reverse();
+    list.clear();
+    CHECK(list.size() == 0);
+
+    ForwardList<int> copy(list);
+    CHECK(copy.size() == 0 && copy.begin() == copy.end());
+}
+
+void TestForwardListOrder() {
+    ForwardList<int> list{1, 2, 3, 4};
+    CHECK(Collect(list) == (std::vector<int>{1, 2, 3, 4}));
+    list.push_front(0);
+    list.reverse();
+    CHECK(Collect(list) == (std::vector<int>{4, 3, 2, 1, 0}));
+    list.pop_front();
+    CHECK(list.front() == 3 && list.size() == 4);
+
+    std::vector<int> values{7, 8, 9};
+    ForwardList<int> ranged(values.begin(), values.end());
+    CHECK(Collect(ranged) == values);
+
+    ForwardList<int> filled(3, 5);
+    CHECK(Collect(filled) == (std::vector<int>{5, 5, 5}));
+}
+
+void TestForwardListCopyMove() {
+    ForwardList<std::string> list{"a", "bb", std::string(40, 'c')};
+    ForwardList<std::string> copy(list);
+    CHECK(copy.size() == 3 && copy.front() == "a");
+    copy.front() = "z";
+    CHECK(list.front() == "a");
+
+    ForwardList<std::string> moved(std::move(copy));
+    CHECK(moved.size() == 3 && moved.front() == "z");
+    CHECK(copy.size() == 0);
+
+    list = moved;
+    CHECK(list.front() == "z");
+    list = ForwardList<std::string>();
+    CHECK(list.size() == 0);
+}
+
+void TestForwardListReusesNodes() {
+    size_t allocations = 0;
+    ForwardList<int, SlabCountingAllocator<int>> list{SlabCountingAllocator<int>(&allocations)};
+    for (int i = 0; i < 1000; ++i) {
+        list.push_front(i);
+    }
+    const size_t after_fill = allocations;
+    // nodes come in doubling slabs, not one by one
+    CHECK(after_fill > 0 && after_fill < 20);
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            list.pop_front();
+        }
+        CHECK(list.size() == 0);
+        for (int i = 0; i < 1000; ++i) {
+            list.push_front(i);
+        }
+    }
+    CHECK(allocations == after_fill);
+    CHECK(list.front() == 999 && list.size() == 1000);
+
+    // clear hands the slabs back, the next push starts from a small one
+    list.clear();
+    list.push_front(1);
+    CHECK(allocations == after_fill + 1 && list.front() == 1);
+}
+
+void TestListEnds() {
+    List<int> list;
+    CHECK(list.empty() && list.begin() == list.end());
+    list.pop_front();
+    list.pop_back();
+    list.reverse();
+    CHECK(list.empty());
+
+    list.push_back(2);
+    list.push_front(1);
+    list.push_back(3);
+    CHECK(list.front() == 1 && list.back() == 3 && list.size() == 3);
+    CHECK(*--list.end() == 3);
+
+    list.pop_back();
+    list.pop_front();
+    CHECK(list.front() == 2 && list.back() == 2 && list.size() == 1);
+    list.pop_back();
+    CHECK(list.empty() && list.begin() == list.end());
+}
+
+void TestListInsertErase() {
+    List<int> list{1, 2, 5};
+    auto it = list.begin();
+    ++it;
+    ++it;
+    it = list.insert(it, 4);
+    it = list.emplace(it, 3);
+    CHECK(*it == 3);
+    CHECK(Collect(list) == (std::vector<int>{1, 2, 3, 4, 5}));
+
+    it = list.erase(it);
+    CHECK(*it == 4);
+    auto last = it;
+    ++last;
+    CHECK(*list.erase(it, last) == 5);
+    CHECK(Collect(list) == (std::vector<int>{1, 2, 5}));
+
+    CHECK(list.erase(list.begin(), list.end()) == list.end());
+    CHECK(list.empty());
+}
+
+void TestListSplice() {
+    List<int> list{1, 5};
+    List<int> other{2, 3, 4};
+    auto pos = list.begin();
+    ++pos;
+    list.splice(pos, other);
+    CHECK(Collect(list) == (std::vector<int>{1, 2, 3, 4, 5}));
+    CHECK(other.empty() && list.size() == 5);
+
+    // splicing an empty list or the list itself changes nothing
+    list.splice(list.begin(), other);
+    list.splice(list.begin(), list);
+    CHECK(list.size() == 5);
+
+    // single node, from another list and within the list
+    other.push_back(9);
+    list.splice(list.end(), other, other.begin());
+    CHECK(other.empty() && list.back() == 9 && list.size() == 6);
+    list.splice(list.begin(), list, --list.end());
+    CHECK(Collect(list) == (std::vector<int>{9, 1, 2, 3, 4, 5}));
+    list.splice(list.begin(), list, list.begin());
+    CHECK(list.front() == 9);
+
+    // ranges, counted across lists and not within one
+    auto first = list.begin();
+    ++first;
+    auto last = first;
+    ++last;
+    ++last;
+    other.splice(other.end(), list, first, last);
+    CHECK(Collect(other) == (std::vector<int>{1, 2}) && other.size() == 2);
+    CHECK(Collect(list) == (std::vector<int>{9, 3, 4, 5}) && list.size() == 4);
+
+    first = list.begin();
+    ++first;
+    list.splice(list.begin(), list, first, list.end());
+    CHECK(Collect(list) == (std::vector<int>{3, 4, 5, 9}) && list.size() == 4);
+    list.splice(list.begin(), list, list.begin(), list.begin());
+    CHECK(list.size() == 4);
+}
+
+void TestListReverseCopyMove() {
+    List<std::string> list{"a", "b", std::string(40, 'c')};
+    list.reverse();
+    CHECK(list.front() == std::string(40, 'c') && list.back() == "a");
+
+    List<std::string> copy(list);
+    copy.back() = "z";
+    CHECK(list.back() == "a" && copy.size() == 3);
+
+    List<std::string> moved(std::move(copy));
+    CHECK(moved.back() == "z" && copy.empty() && copy.begin() == copy.end());
+    copy.push_back("new");
+    CHECK(copy.front() == "new");
+
+    list = moved;
+    CHECK(list.back() == "z");
+    moved = std::move(copy);
+    CHECK(moved.size() == 1 && moved.front() == "new");
+
+    List<int> single{1};
+    single.reverse();
+    CHECK(single.front() == 1 && single.back() == 1);
+}
+
+void TestUnrolledEmpty() {
+    UnrolledForwardList<int, 4> list;
+    CHECK(list.size() == 0 && list.begin() == list.end());
+    list.pop_front();
+    list.reverse();
+    CHECK(list.size() == 0);
+
+    UnrolledForwardList<int, 4> copy(list);
+    CHECK(copy.size() == 0 && copy.begin() == copy.end());
+    copy.push_front(1);
+    CHECK(copy.front() == 1 && list.size() == 0);
+}
+
+// every count around the node boundaries at multiples of K
+void TestUnrolledNodeBoundaries() {
+    for (int count = 0; count <= 13; ++count) {
+        UnrolledForwardList<int, 4> list;
+        std::vector<int> expected;
+        for (int i = 0; i < count; ++i) {
+            list.push_front(i);
+            expected.insert(expected.begin(), i);
+        }
+        CHECK(list.size() == static_cast<size_t>(count));
+        CHECK(Collect(list) == expected);
+
+        UnrolledForwardList<int, 4> copy(list);
+        CHECK(Collect(copy) == expected);
+
+        list.reverse();
+        std::vector<int> reversed(expected.rbegin(), expected.rend());
+        CHECK(Collect(list) == reversed);
+        // a reversed list keeps a partly filled node at the tail
+        list.push_front(-1);
+        reversed.insert(reversed.begin(), -1);
+        CHECK(Collect(list) == reversed);
+
+        for (int i = 0; i <= count; ++i) {
+            CHECK(list.front() == reversed[i]);
+            list.pop_front();
+        }
+        CHECK(list.size() == 0 && list.begin() == list.end());
+    }
+}
+
+void TestUnrolledStrings() {
+    UnrolledForwardList<std::string, 3> list{"a", "b", "c", "d", std::string(40, 'e')};
+    CHECK(list.size() == 5 && list.front() == "a");
+
+    UnrolledForwardList<std::string, 3> copy(list);
+    copy.front() = "z";
+    CHECK(list.front() == "a");
+
+    std::string moved_from(40, 'f');
+    copy.push_front(std::move(moved_from));
+    CHECK(copy.front() == std::string(40, 'f') && copy.size() == 6);
+
+    UnrolledForwardList<std::string, 3> moved(std::move(copy));
+    CHECK(moved.size() == 6 && copy.size() == 0);
+
+    list = moved;
+    list.reverse();
+    CHECK(list.front() == std::string(40, 'e'));
+    list.pop_front();
+    list.pop_front();
+    CHECK(list.front() == "c" && list.size() == 4);
+
+    list.clear();
+    CHECK(list.size() == 0);
+    list.emplace_front(2, 'x');
+    CHECK(list.front() == "xx");
+}
+
+void TestUnrolledDefaultCapacity() {
+    // small values share a cache line, large ones still come a few per node
+    CHECK(UnrolledForwardList<int>::kNodeCapacity == 12);
+    CHECK(UnrolledForwardList<std::string>::kNodeCapacity == 4);
+    CHECK(sizeof(UnrolledNode<int, 12>) == kCacheLineSize);
+}
+
+// the values of a full node share one cache line, also in pooled slabs
+void TestUnrolledNodeAlignment() {
+    const size_t kCapacity = UnrolledForwardList<int>::kNodeCapacity;
+    size_t allocations = 0;
+    UnrolledForwardList<int, kCapacity, SlabCountingAllocator<int>> list{SlabCountingAllocator<int>(&allocations)};
+    for (size_t i = 0; i < 40 * kCapacity; ++i) {
+        list.push_front(static_cast<int>(i));
+    }
+    size_t idx = 0;
+    uintptr_t line = 0;
+    for (auto it = list.begin(); it != list.end(); ++it, ++idx) {
+        const uintptr_t this_line = reinterpret_cast<uintptr_t>(&*it) / kCacheLineSize;
+        if (idx % kCapacity == 0) {
+            line = this_line;
+        }
+        CHECK(this_line == line);
+    }
+    CHECK(idx == 40 * kCapacity && allocations > 1);
+}
+
+int main() {
+    TestForwardListEmpty();
+    TestForwardListOrder();
+    TestForwardListCopyMove();
+    TestForwardListReusesNodes();
+    TestListEnds();
+    TestListInsertErase();
+    TestListSplice();
+    TestListReverseCopyMove();
+    TestUnrolledEmpty();
+    TestUnrolledNodeBoundaries();
+    TestUnrolledStrings();
+    TestUnrolledDefaultCapacity();
+    TestUnrolledNodeAlignment();
+    return 0;
+}
@@ -0,0 +1,283 @@
+#include "addressablePriorityQueue.h"
+#include "concurrentPriorityQueue.h"
+#include "priorityQueue.h"
+#include "testCheck.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <class Queue>
+std::vector<int> Drain(Queue& queue) {
+    std::vector<int> result;
+    while (!queue.Empty()) {
+        result.push_back(queue.Top());
+        queue.Pop();
+    }
+    return result;
+}
+
+template <class Layout>
+void TestLayoutPopsInOrder() {
+    PriorityQueue<int, std::vector<int>, std::less<int>, Layout> queue;
+    CHECK(queue.Empty() && queue.Size() == 0);
+
+    std::mt19937 generator(17);
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(static_cast<int>(generator() % 100));
+        queue.Push(values.back());
+        CHECK(queue.Top() == *std::max_element(values.begin(), values.end()));
+    }
+    std::sort(values.rbegin(), values.rend());
+    CHECK(Drain(queue) == values);
+
+    queue.Push(5);
+    queue.Pop();
+    CHECK(queue.Empty());
+
+    PriorityQueue<int, std::vector<int>, std::greater<int>, Layout> heapified(std::vector<int>{5, 3, 9, 1, 7});
+    CHECK(Drain(heapified) == (std::vector<int>{1, 3, 5, 7, 9}));
+}
+
+void TestAddressableHandles() {
+    AddressablePriorityQueue<int, std::greater<int>, QuaternaryHeap> queue;
+    CHECK(queue.Empty() && !queue.Contains(0));
+
+    std::vector<AddressablePriorityQueue<int>::Handle> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.push_back(queue.Push(1000 + i));
+    }
+    CHECK(queue.Top() == 1000 && queue.TopHandle() == handles[0]);
+
+    // Dijkstra-style relaxation moves an element to the top
+    queue.DecreaseKey(handles[50], 5);
+    CHECK(queue.Top() == 5 && queue.TopHandle() == handles[50]);
+    queue.Update(handles[50], 2000);
+    CHECK(queue.Top() == 1000 && queue.Get(handles[50]) == 2000);
+    queue.Update(handles[99], 1);
+    CHECK(queue.TopHandle() == handles[99]);
+
+    queue.Erase(handles[0]);
+    CHECK(!queue.Contains(handles[0]) && queue.Size() == 99);
+    queue.Pop();
+    CHECK(!queue.Contains(handles[99]) && queue.Top() == 1001);
+
+    // every other handle still reaches its own value
+    for (int i = 1; i < 99; ++i) {
+        CHECK(queue.Contains(handles[i]));
+        CHECK(queue.Get(handles[i]) == (i == 50 ? 2000 : 1000 + i));
+    }
+
+    // freed handles are handed out again
+    const auto reused = queue.Push(0);
+    CHECK((reused == handles[0] || reused == handles[99]) && queue.Top() == 0);
+
+    queue.Clear();
+    CHECK(queue.Empty() && !queue.Contains(reused));
+}
+
+// built from a negative number it throws
+struct Checked {
+    int value_;
+
+    explicit Checked(int value) : value_(value) {
+        if (value < 0) {
+            throw std::invalid_argument("negative");
+        }
+    }
+
+    bool operator<(const Checked& other) const {
+        return value_ < other.value_;
+    }
+};
+
+// a failed Emplace hands out no handle and loses none
+void TestAddressableThrowingEmplace() {
+    AddressablePriorityQueue<Checked> queue;
+    const auto first = queue.Emplace(1);
+    const auto second = queue.Emplace(2);
+    queue.Erase(first);
+
+    for (int round = 0; round < 2; ++round) {
+        bool thrown = false;
+        try {
+            queue.Emplace(-1);
+        } catch (const std::invalid_argument&) {
+            thrown = true;
+        }
+        CHECK(thrown && queue.Size() == 1 && queue.TopHandle() == second);
+        // the freed handle is still the one handed out next
+        const auto reused = queue.Emplace(3);
+        CHECK(reused == first && queue.Top().value_ == 3 && queue.Get(second).value_ == 2);
+        queue.Pop();
+    }
+
+    // with no freed handle left, a fresh one comes next
+    queue.Emplace(5);
+    bool thrown = false;
+    try {
+        queue.Emplace(-5);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    const auto fresh = queue.Emplace(4);
+    CHECK(thrown && fresh == 2 && queue.Size() == 3 && queue.Get(fresh).value_ == 4);
+}
+
+// random operations against a plain vector searched by brute force
+void TestAddressableMatchesBruteForce() {
+    AddressablePriorityQueue<int> queue;
+    std::vector<std::pair<AddressablePriorityQueue<int>::Handle, int>> live;
+    std::mt19937 generator(19);
+
+    for (int step = 0; step < 20000; ++step) {
+        const unsigned op = generator() % 4;
+        if (op == 0 || live.empty()) {
+            const int value = static_cast<int>(generator() % 1000);
+            live.emplace_back(queue.Push(value), value);
+        } else if (op == 1) {
+            const size_t at = generator() % live.size();
+            live[at].second = static_cast<int>(generator() % 1000);
+            queue.Update(live[at].first, live[at].second);
+        } else if (op == 2) {
+            const size_t at = generator() % live.size();
+            queue.Erase(live[at].first);
+            live.erase(live.begin() + at);
+        } else {
+            auto best = std::max_element(live.begin(), live.end(),
+                                         [](const auto& a, const auto& b) { return a.second < b.second; });
+            CHECK(queue.Top() == best->second);
+            live.erase(std::find_if(live.begin(), live.end(),
+                                    [&](const auto& entry) { return entry.first == queue.TopHandle(); }));
+            queue.Pop();
+        }
+        CHECK(queue.Size() == live.size());
+    }
+}
+
+// small batches are sifted up one by one, large ones rebuild the heap;
+// both must leave a valid heap, also when the queue starts out empty
+void TestPushRange() {
+    for (size_t initial : {0, 1, 100}) {
+        for (size_t batch : {0, 1, 5, 13, 1000}) {
+            PriorityQueue<int, std::vector<int>, std::less<int>, QuaternaryHeap> queue;
+            std::vector<int> expected;
+            std::mt19937 generator(static_cast<unsigned>(initial * 31 + batch));
+            for (size_t i = 0; i < initial; ++i) {
+                expected.push_back(static_cast<int>(generator() % 500));
+                queue.Push(expected.back());
+            }
+
+            std::vector<int> range;
+            for (size_t i = 0; i < batch; ++i) {
+                range.push_back(static_cast<int>(generator() % 500));
+            }
+            queue.PushRange(range.begin(), range.end());
+            expected.insert(expected.end(), range.begin(), range.end());
+
+            CHECK(queue.Size() == expected.size());
+            std::sort(expected.rbegin(), expected.rend());
+            CHECK(Drain(queue) == expected);
+        }
+    }
+
+    // an already sorted batch is the worst case for sifting up
+    PriorityQueue<int> sorted;
+    std::vector<int> ascending(500);
+    for (int i = 0; i < 500; ++i) {
+        ascending[i] = i;
+    }
+    sorted.Push(-1);
+    sorted.PushRange(ascending.begin(), ascending.begin() + 10);
+    sorted.PushRange(ascending.begin() + 10, ascending.end());
+    CHECK(sorted.Top() == 499 && sorted.Size() == 501);
+}
+
+void TestConcurrentQueueEmpty() {
+    ConcurrentPriorityQueue<int> queue(4);
+    CHECK(queue.Empty() && queue.QueueCount() == 4 && queue.Choices() == 2);
+    CHECK(!queue.Top().has_value() && !queue.Pop().has_value());
+    int item = 7;
+    CHECK(!queue.TryPop(item) && item == 7);
+
+    // choices are clamped to the queue count
+    ConcurrentPriorityQueue<int> single(1, 5);
+    CHECK(single.QueueCount() == 1 && single.Choices() == 1);
+    single.Push(3);
+    CHECK(*single.Top() == 3 && *single.Pop() == 3 && single.Empty());
+}
+
+// sampling every queue makes the MultiQueue exact
+void TestConcurrentQueueStrictWhenSamplingAll() {
+    ConcurrentPriorityQueue<int> queue(4, 4);
+    std::vector<int> values;
+    std::mt19937 generator(23);
+    for (int i = 0; i < 500; ++i) {
+        values.push_back(static_cast<int>(generator() % 1000));
+        queue.Push(values.back());
+    }
+    std::sort(values.rbegin(), values.rend());
+    for (int value : values) {
+        CHECK(*queue.Pop() == value);
+    }
+    CHECK(queue.Empty() && !queue.Pop().has_value());
+}
+
+// relaxed order, but every pushed value comes out exactly once
+void TestConcurrentQueueThreads() {
+    ConcurrentPriorityQueue<int> queue(8);
+    const int kThreads = 4;
+    const int kPerThread = 5000;
+    std::vector<std::vector<int>> popped(kThreads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&queue, &popped, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                queue.Push(t * kPerThread + i);
+                if (i % 2 == 1) {
+                    int item;
+                    if (queue.TryPop(item)) {
+                        popped[t].push_back(item);
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<int> all;
+    for (const std::vector<int>& part : popped) {
+        all.insert(all.end(), part.begin(), part.end());
+    }
+    while (std::optional<int> item = queue.Pop()) {
+        all.push_back(*item);
+    }
+    CHECK(queue.Empty());
+    std::sort(all.begin(), all.end());
+    CHECK(all.size() == kThreads * kPerThread);
+    for (int i = 0; i < kThreads * kPerThread; ++i) {
+        CHECK(all[i] == i);
+    }
+}
+
+int main() {
+    TestLayoutPopsInOrder<BinaryHeap>();
+    TestLayoutPopsInOrder<DaryHeap<3>>();
+    TestLayoutPopsInOrder<QuaternaryHeap>();
+    TestLayoutPopsInOrder<DaryHeap<8>>();
+    TestAddressableHandles();
+    TestAddressableMatchesBruteForce();
+    TestAddressableThrowingEmplace();
+    TestPushRange();
+    TestConcurrentQueueEmpty();
+    TestConcurrentQueueStrictWhenSamplingAll();
+    TestConcurrentQueueThreads();
+    return 0;
+}
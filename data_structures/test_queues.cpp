@@ -0,0 +1,263 @@
+#include "Stack_Queue/LockFreeStack.h"
+#include "Stack_Queue/Queue.h"
+#include "Stack_Queue/RingQueue.h"
+#include "Stack_Queue/Stack.h"
+#include "testCheck.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct alignas(64) Padded {
+    int value_;
+};
+
+void TestStack() {
+    // the pre-template name still means a stack of ints
+    Stack ints;
+    CHECK(ints.Empty() && ints.Size() == 0);
+    for (int i = 0; i < 100; ++i) {
+        ints.Push(i);
+    }
+    CHECK(ints.Top() == 99 && ints.Size() == 100);
+    ints.Pop();
+    CHECK(ints.Top() == 98);
+    ints.Clear();
+    CHECK(ints.Empty());
+
+    BasicStack<std::string> strings;
+    strings.Push(std::string(40, 'a'));
+    strings.Emplace(3, 'b');
+    BasicStack<std::string> copy(strings);
+    copy.Pop();
+    CHECK(copy.Top() == std::string(40, 'a') && strings.Top() == "bbb");
+    copy.Swap(strings);
+    CHECK(strings.Size() == 1 && copy.Size() == 2);
+}
+
+void TestQueueWrapsAndGrows() {
+    Queue queue;
+    CHECK(queue.Empty());
+    Queue empty_copy(queue);
+    CHECK(empty_copy.Empty());
+    queue.Reserve(0);
+
+    // the head moves forward first, so growth has to unwrap the values
+    int next_push = 0;
+    int next_pop = 0;
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 7; ++i) {
+            queue.Push(next_push++);
+        }
+        for (int i = 0; i < 5; ++i) {
+            CHECK(queue.Front() == next_pop++);
+            queue.Pop();
+        }
+        CHECK(queue.Back() == next_push - 1);
+        CHECK(queue.Size() == static_cast<size_t>(next_push - next_pop));
+    }
+
+    Queue copy(queue);
+    while (!queue.Empty()) {
+        CHECK(copy.Front() == queue.Front());
+        queue.Pop();
+        copy.Pop();
+    }
+    CHECK(copy.Empty());
+}
+
+void TestQueueOverAligned() {
+    BasicQueue<Padded> queue;
+    queue.Reserve(3);
+    for (int i = 0; i < 40; ++i) {
+        queue.Push(Padded{i});
+        CHECK(reinterpret_cast<uintptr_t>(&queue.Back()) % alignof(Padded) == 0);
+    }
+    for (int i = 0; i < 40; ++i) {
+        CHECK(queue.Front().value_ == i);
+        queue.Pop();
+    }
+
+    BasicQueue<std::string> strings;
+    strings.Emplace(40, 'x');
+    strings.Push("y");
+    BasicQueue<std::string> moved(std::move(strings));
+    CHECK(strings.Empty() && moved.Front() == std::string(40, 'x'));
+    strings = moved;
+    CHECK(strings.Back() == "y" && moved.Size() == 2);
+}
+
+void TestRoundUpToPowerOfTwo() {
+    CHECK(RoundUpToPowerOfTwo(0) == 1);
+    CHECK(RoundUpToPowerOfTwo(1) == 1);
+    CHECK(RoundUpToPowerOfTwo(5) == 8);
+    CHECK(RoundUpToPowerOfTwo(8) == 8);
+    CHECK(RoundUpToPowerOfTwo(1025) == 2048);
+}
+
+template <class Ring>
+void TestFullAndEmpty() {
+    CHECK(Ring(0).Capacity() == 2);
+    CHECK(Ring(1).Capacity() == 2);
+    CHECK(Ring(6).Capacity() == 8);
+
+    Ring queue(5);
+    std::string value;
+    CHECK(queue.Empty() && !queue.TryPop(value));
+
+    // several laps, so that positions wrap around the ring
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 8; ++i) {
+            CHECK(queue.TryPush(std::to_string(lap * 8 + i)));
+        }
+        CHECK(queue.Size() == 8 && !queue.TryPush("full"));
+        for (int i = 0; i < 8; ++i) {
+            CHECK(queue.TryPop(value) && value == std::to_string(lap * 8 + i));
+        }
+        CHECK(queue.Empty() && !queue.TryPop(value));
+    }
+
+    CHECK(queue.TryEmplace(40, 'x'));
+    queue.Push("blocking");
+    CHECK(queue.Pop() == std::string(40, 'x'));
+    CHECK(queue.Pop() == "blocking");
+
+    // values left behind are destroyed with the queue
+    queue.Push(std::string(50, 'y'));
+    queue.Push(std::string(50, 'z'));
+}
+
+void TestSpscThreads() {
+    const int kCount = 100000;
+    SpscQueue<int> queue(64);
+    std::thread producer([&queue] {
+        for (int i = 0; i < kCount; ++i) {
+            queue.Push(i);
+        }
+    });
+    bool in_order = true;
+    for (int i = 0; i < kCount; ++i) {
+        in_order = in_order && queue.Pop() == i;
+    }
+    producer.join();
+    CHECK(in_order && queue.Empty());
+}
+
+// every pushed value pops exactly once, and each producer's values keep
+// their order
+void TestMpmcThreads() {
+    const int kThreads = 4;
+    const int kPerThread = 20000;
+    MpmcQueue<int> queue(128);
+    std::vector<std::vector<int>> popped(kThreads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&queue, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                queue.Push(t * kPerThread + i);
+            }
+        });
+        threads.emplace_back([&queue, &popped, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                popped[t].push_back(queue.Pop());
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK(queue.Empty());
+
+    std::vector<int> seen(kThreads * kPerThread, 0);
+    for (const std::vector<int>& values : popped) {
+        std::vector<int> last(kThreads, -1);
+        for (const int value : values) {
+            ++seen[value];
+            CHECK(value > last[value / kPerThread]);
+            last[value / kPerThread] = value;
+        }
+    }
+    for (const int count : seen) {
+        CHECK(count == 1);
+    }
+}
+
+void TestLockFreeStackSingleThread() {
+    LockFreeStack<std::string> stack;
+    std::string value;
+    CHECK(stack.Empty() && stack.Size() == 0);
+    CHECK(!stack.TryPop(value) && !stack.Pop());
+
+    for (int i = 0; i < 1000; ++i) {
+        stack.Push(std::to_string(i));
+    }
+    stack.Emplace(40, 'x');
+    CHECK(stack.Size() == 1001);
+    CHECK(*stack.Pop() == std::string(40, 'x'));
+    for (int i = 999; i >= 500; --i) {
+        CHECK(stack.TryPop(value) && value == std::to_string(i));
+    }
+    // the rest is freed by the destructor
+    CHECK(stack.Size() == 500 && !stack.Empty());
+}
+
+// every value pushed by some thread is popped by exactly one thread; the
+// short-lived poppers leave their retired nodes behind as orphans
+void TestLockFreeStackThreads() {
+    const int kThreads = 4;
+    const int kPerThread = 20000;
+    LockFreeStack<int> stack;
+    std::vector<std::vector<int>> popped(kThreads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&stack, &popped, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                stack.Push(t * kPerThread + i);
+                if (i % 2 == 1) {
+                    for (int k = 0; k < 2; ++k) {
+                        if (std::optional<int> value = stack.Pop()) {
+                            popped[t].push_back(*value);
+                        }
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<int> seen(kThreads * kPerThread, 0);
+    while (std::optional<int> value = stack.Pop()) {
+        ++seen[*value];
+    }
+    CHECK(stack.Empty() && stack.Size() == 0);
+    for (const std::vector<int>& values : popped) {
+        for (const int value : values) {
+            ++seen[value];
+        }
+    }
+    for (const int count : seen) {
+        CHECK(count == 1);
+    }
+}
+
+int main() {
+    TestStack();
+    TestQueueWrapsAndGrows();
+    TestQueueOverAligned();
+    TestRoundUpToPowerOfTwo();
+    TestFullAndEmpty<SpscQueue<std::string>>();
+    TestFullAndEmpty<MpmcQueue<std::string>>();
+    TestSpscThreads();
+    TestMpmcThreads();
+    TestLockFreeStackSingleThread();
+    TestLockFreeStackThreads();
+    return 0;
+}
@@ -0,0 +1,349 @@
+#include "../smart_pointers/intrusive_ptr.h"
+#include "../smart_pointers/shared_ptr.h"
+#include "testCheck.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+std::atomic<int> alive{0};
+
+struct Tracked {
+    int value_;
+
+    explicit Tracked(int value) : value_(value) {
+        ++alive;
+    }
+
+    ~Tracked() {
+        --alive;
+    }
+};
+
+template <class Policy>
+void TestSharedAndWeak() {
+    using Shared = SharedPtr<Tracked, Policy>;
+    using Weak = WeakPtr<Tracked, Policy>;
+
+    const Shared empty;
+    CHECK(!empty && empty.Get() == nullptr && empty.UseCount() == 0);
+    const Weak weak_of_empty(empty);
+    CHECK(weak_of_empty.Expired() && !weak_of_empty.Lock());
+    CHECK(Weak().Expired() && !Weak().Lock());
+
+    Shared first(new Tracked(1));
+    CHECK(first && first->value_ == 1 && (*first).value_ == 1 && first.UseCount() == 1);
+    {
+        Shared second = first;
+        CHECK(first.UseCount() == 2 && second.Get() == first.Get());
+    }
+    CHECK(first.UseCount() == 1);
+
+    Weak weak(first);
+    CHECK(!weak.Expired() && weak.UseCount() == 1);
+    {
+        Shared locked = weak.Lock();
+        CHECK(locked && locked->value_ == 1 && first.UseCount() == 2);
+        Shared constructed(weak);
+        CHECK(first.UseCount() == 3);
+    }
+
+    // the object dies with its last owner while the weak pointer lives on
+    first.Reset(new Tracked(2));
+    CHECK(alive == 1 && weak.Expired() && weak.UseCount() == 0);
+    CHECK(!weak.Lock() && weak.Lock().Get() == nullptr);
+    bool thrown = false;
+    try {
+        Shared from_expired(weak);
+    } catch (const BadWeakPtr&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    Weak copied = weak;
+    Weak moved(std::move(copied));
+    CHECK(moved.Expired() && copied.Expired());
+    weak.Reset();
+
+    Weak second_weak(first);
+    Shared taken(std::move(first));
+    CHECK(!first && first.UseCount() == 0 && taken.UseCount() == 1);
+    Shared other(new Tracked(3));
+    taken.Swap(other);
+    CHECK(taken->value_ == 3 && other->value_ == 2 && !second_weak.Expired());
+    other = taken;
+    CHECK(alive == 1 && second_weak.Expired() && taken.UseCount() == 2);
+    other = std::move(taken);
+    other.Reset();
+    CHECK(alive == 1);
+    taken.Reset();
+    CHECK(alive == 0);
+}
+
+// copies on some threads, Lock on others, while the last outside owner
+// lets go; the object must die exactly once and Lock must never revive it
+void TestSharedThreads() {
+    for (int round = 0; round < 200; ++round) {
+        SharedPtr<Tracked> shared(new Tracked(round));
+        const WeakPtr<Tracked> weak(shared);
+        std::vector<SharedPtr<Tracked>> copies(2, shared);
+        std::atomic<bool> wrong_value{false};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                if (t < 2) {
+                    SharedPtr<Tracked> mine = std::move(copies[t]);
+                    for (int i = 0; i < 1000; ++i) {
+                        SharedPtr<Tracked> copy = mine;
+                        WeakPtr<Tracked> weak_copy(copy);
+                        wrong_value = wrong_value || copy->value_ != round;
+                    }
+                } else {
+                    for (int i = 0; i < 1000; ++i) {
+                        if (SharedPtr<Tracked> locked = weak.Lock()) {
+                            wrong_value = wrong_value || locked->value_ != round;
+                        }
+                    }
+                }
+            });
+        }
+        threads.emplace_back([&shared] {
+            shared.Reset();
+        });
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        CHECK(!wrong_value && weak.Expired() && !weak.Lock());
+    }
+    CHECK(alive == 0);
+}
+
+struct Throwing {
+    std::string text_;
+
+    Throwing(std::string text, bool fail) : text_(std::move(text)) {
+        if (fail) {
+            throw std::runtime_error("constructor failed");
+        }
+        ++alive;
+    }
+
+    ~Throwing() {
+        --alive;
+    }
+};
+
+size_t allocations = 0;
+size_t deallocations = 0;
+
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>& /*other*/) {
+    }
+
+    T* allocate(size_t n) {
+        ++allocations;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        ++deallocations;
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <class U>
+    bool operator==(const CountingAllocator<U>& /*other*/) const {
+        return true;
+    }
+
+    template <class U>
+    bool operator!=(const CountingAllocator<U>& /*other*/) const {
+        return false;
+    }
+};
+
+void TestMakeShared() {
+    SharedPtr<Tracked> made = MakeShared<Tracked>(5);
+    CHECK(made->value_ == 5 && made.UseCount() == 1 && alive == 1);
+    WeakPtr<Tracked> weak(made);
+    SharedPtr<Tracked> copy = made;
+    made.Reset();
+    CHECK(copy.UseCount() == 1 && !weak.Expired());
+    copy.Reset();
+    CHECK(alive == 0 && weak.Expired() && !weak.Lock());
+
+    LocalSharedPtr<Tracked> local = MakeLocalShared<Tracked>(6);
+    LocalWeakPtr<Tracked> local_weak(local);
+    CHECK(local_weak.Lock()->value_ == 6);
+    CHECK(local.UseCount() == 1);
+    local.Reset();
+    CHECK(alive == 0 && !local_weak.Lock());
+}
+
+// one block for object and counts; it outlives the object while weak
+// pointers remain, and nothing leaks when the constructor throws
+void TestAllocateShared() {
+    allocations = 0;
+    deallocations = 0;
+    SharedPtr<Throwing> shared = AllocateShared<Throwing>(CountingAllocator<Throwing>(), "in place", false);
+    CHECK(allocations == 1 && shared->text_ == "in place" && alive == 1);
+
+    WeakPtr<Throwing> weak(shared);
+    shared.Reset();
+    CHECK(alive == 0 && deallocations == 0 && weak.Expired());
+    weak.Reset();
+    CHECK(deallocations == 1);
+
+    bool thrown = false;
+    try {
+        AllocateShared<Throwing>(CountingAllocator<Throwing>(), "never", true);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CHECK(thrown && alive == 0 && allocations == 2 && deallocations == 2);
+
+    // a SharedPtr adopting a raw pointer still works next to the in-place ones
+    SharedPtr<Throwing> adopted(new Throwing("raw", false));
+    adopted.Reset(new Throwing("raw again", false));
+    CHECK(alive == 1 && adopted->text_ == "raw again");
+    adopted.Reset();
+    CHECK(alive == 0);
+}
+
+struct Node : RefCounted<Node> {
+    int value_;
+
+    explicit Node(int value) : value_(value) {
+        ++alive;
+    }
+
+    Node(const Node& other) : RefCounted(other), value_(other.value_) {
+        ++alive;
+    }
+
+    ~Node() {
+        --alive;
+    }
+};
+
+struct LocalNode : RefCounted<LocalNode, PlainRefCount> {
+    ~LocalNode() {
+        --alive;
+    }
+};
+
+// counts its own references instead of deriving from RefCounted
+struct OwnCount {
+    int refs_ = 0;
+};
+
+int own_count_deleted = 0;
+
+void IntrusiveAddRef(OwnCount* obj) {
+    ++obj->refs_;
+}
+
+void IntrusiveRelease(OwnCount* obj) {
+    if (--obj->refs_ == 0) {
+        ++own_count_deleted;
+        delete obj;
+    }
+}
+
+void TestIntrusivePtr() {
+    const IntrusivePtr<Node> empty;
+    CHECK(!empty && empty.Get() == nullptr);
+
+    IntrusivePtr<Node> first = MakeIntrusive<Node>(3);
+    CHECK(first->value_ == 3 && first->UseCount() == 1);
+    IntrusivePtr<Node> second = first;
+    // the count lives in the object, so a raw pointer can be wrapped again
+    IntrusivePtr<Node> from_raw(first.Get());
+    CHECK(first->UseCount() == 3 && (*from_raw).value_ == 3);
+
+    // Detach hands a reference out, add_ref = false takes it back
+    Node* raw = from_raw.Detach();
+    CHECK(!from_raw && first->UseCount() == 3);
+    IntrusivePtr<Node> adopted(raw, false);
+    CHECK(first->UseCount() == 3);
+
+    first.Reset();
+    adopted.Reset();
+    CHECK(second->UseCount() == 1 && alive == 1);
+    IntrusivePtr<Node> taken(std::move(second));
+    CHECK(!second && taken->UseCount() == 1);
+    taken.Swap(first);
+    first.Reset(new Node(4));
+    CHECK(alive == 1 && first->value_ == 4);
+    first.Reset();
+    CHECK(alive == 0);
+
+    // a copy of the object is a new object with no references yet
+    IntrusivePtr<Node> original = MakeIntrusive<Node>(5);
+    IntrusivePtr<Node> copied = MakeIntrusive<Node>(*original);
+    CHECK(original->UseCount() == 1 && copied->UseCount() == 1 && copied->value_ == 5);
+    original.Reset();
+    copied.Reset();
+    CHECK(alive == 0);
+
+    ++alive;
+    IntrusivePtr<LocalNode> local(new LocalNode);
+    IntrusivePtr<LocalNode> local_copy = local;
+    CHECK(local->UseCount() == 2);
+    local.Reset();
+    local_copy.Reset();
+    CHECK(alive == 0);
+
+    {
+        IntrusivePtr<OwnCount> own(new OwnCount);
+        IntrusivePtr<OwnCount> own_copy = own;
+        CHECK(own->refs_ == 2);
+    }
+    CHECK(own_count_deleted == 1);
+}
+
+void TestIntrusiveThreads() {
+    for (int round = 0; round < 100; ++round) {
+        IntrusivePtr<Node> node = MakeIntrusive<Node>(round);
+        std::vector<IntrusivePtr<Node>> copies(4, node);
+        node.Reset();
+        std::atomic<bool> wrong_value{false};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                IntrusivePtr<Node> mine = std::move(copies[t]);
+                for (int i = 0; i < 1000; ++i) {
+                    IntrusivePtr<Node> copy = mine;
+                    wrong_value = wrong_value || copy->value_ != round;
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        CHECK(!wrong_value && alive == 0);
+    }
+}
+
+int main() {
+    TestSharedAndWeak<AtomicRefCount>();
+    TestSharedAndWeak<PlainRefCount>();
+    TestSharedThreads();
+    TestMakeShared();
+    TestAllocateShared();
+    TestIntrusivePtr();
+    TestIntrusiveThreads();
+    return 0;
+}
@@ -0,0 +1,641 @@
+#include "String/Rope.hpp"
+#include "String/String.hpp"
+#include "String/StringPool.hpp"
+#include "allocators.h"
+#include "testCheck.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// counts what is taken from the heap and not yet given back
+class CountingResource : public MemoryResource {
+public:
+    size_t allocations_ = 0;
+    size_t live_ = 0;
+
+    void* Allocate(size_t bytes, size_t alignment) override {
+        ++allocations_;
+        ++live_;
+        return DefaultResource()->Allocate(bytes, alignment);
+    }
+
+    void Deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        --live_;
+        DefaultResource()->Deallocate(ptr, bytes, alignment);
+    }
+};
+
+bool Holds(const String& str, const char* expected) {
+    return str.Size() == std::strlen(expected) && std::strcmp(str.CStr(), expected) == 0;
+}
+
+void TestInlineBoundary() {
+    CountingResource resource;
+    {
+        String str(&resource);
+        CHECK(str.Empty() && Holds(str, "") && str.Capacity() == String::kInlineCapacity);
+
+        const String longest(String::kInlineCapacity, 'a');
+        str = String(longest.CStr(), longest.Size(), &resource);
+        CHECK(resource.allocations_ == 0 && str.Capacity() == String::kInlineCapacity);
+
+        // the 24th character moves the string to the heap, keeping the rest
+        str.PushBack('b');
+        CHECK(resource.allocations_ == 1 && str.Capacity() > String::kInlineCapacity);
+        CHECK(str.Size() == 24 && str[22] == 'a' && str.Back() == 'b' && str.CStr()[24] == '\0');
+
+        // and back inline once it fits again
+        str.PopBack();
+        str.ShrinkToFit();
+        CHECK(resource.live_ == 0 && str.Capacity() == String::kInlineCapacity);
+        CHECK(str == longest);
+
+        str.Resize(100, 'c');
+        CHECK(resource.live_ == 1 && str.Size() == 100 && str.Back() == 'c');
+        str.Resize(3);
+        CHECK(Holds(str, "aaa"));
+        str.Clear();
+        CHECK(Holds(str, ""));
+    }
+    CHECK(resource.live_ == 0);
+}
+
+void TestMoves() {
+    String empty;
+    String moved_empty(std::move(empty));
+    CHECK(Holds(moved_empty, "") && Holds(empty, ""));
+
+    String short_str("short");
+    String long_str(40, 'x');
+    const char* long_buffer = long_str.CStr();
+
+    String from_short(std::move(short_str));
+    CHECK(Holds(from_short, "short") && Holds(short_str, ""));
+    // a heap buffer changes hands instead of being copied
+    String from_long(std::move(long_str));
+    CHECK(from_long.CStr() == long_buffer && from_long.Size() == 40);
+    CHECK(Holds(long_str, "") && long_str.Capacity() == String::kInlineCapacity);
+
+    // moved-from strings stay usable
+    long_str = "again";
+    short_str += long_str;
+    CHECK(Holds(short_str, "again"));
+
+    from_short = std::move(from_long);
+    CHECK(from_short.CStr() == long_buffer && Holds(from_long, ""));
+    from_long = std::move(short_str);
+    CHECK(Holds(from_long, "again"));
+
+    String& alias = from_long;
+    from_long = std::move(alias);
+    CHECK(Holds(from_long, "again"));
+}
+
+void TestCopiesAndSwap() {
+    String str(30, 'y');
+    const String& alias = str;
+    str = alias;
+    CHECK(str.Size() == 30 && str[29] == 'y');
+
+    // appending a string to itself across the inline boundary
+    String twice("0123456789ab");
+    twice += twice;
+    CHECK(Holds(twice, "0123456789ab0123456789ab"));
+    twice.Append(twice.CStr() + 20, 4);
+    CHECK(Holds(twice, "0123456789ab0123456789ab89ab"));
+
+    String small("small");
+    String large(50, 'z');
+    small.Swap(large);
+    CHECK(small.Size() == 50 && Holds(large, "small"));
+    small.Swap(small);
+    CHECK(small.Size() == 50);
+
+    String copy(large);
+    copy += " and more than twenty-three";
+    CHECK(Holds(large, "small") && Holds(copy, "small and more than twenty-three"));
+    copy = large;
+    CHECK(copy == large);
+    CHECK(Holds('<' + copy + ">" + '!', "<small>!"));
+}
+
+std::string RandomText(std::mt19937& generator, size_t size, const char* alphabet) {
+    const size_t letters = std::strlen(alphabet);
+    std::string text;
+    for (size_t i = 0; i < size; ++i) {
+        text.push_back(alphabet[generator() % letters]);
+    }
+    return text;
+}
+
+int Sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+// the block loops against std::string on lengths around the block widths,
+// so that matches and mismatches fall in blocks as well as in the tails
+void TestCompareMatchesStd() {
+    std::mt19937 generator(19);
+    for (int round = 0; round < 2000; ++round) {
+        const std::string left = RandomText(generator, generator() % 70, "ab");
+        std::string right = left.substr(0, generator() % (left.size() + 1));
+        if (generator() % 2 == 0) {
+            right += RandomText(generator, generator() % 40, "ab");
+        }
+        const String lhs(left.c_str(), left.size());
+        const String rhs(right.c_str(), right.size());
+        const int expected = Sign(left.compare(right));
+        CHECK(Sign(StringView(lhs).Compare(rhs)) == expected);
+        CHECK((lhs == rhs) == (expected == 0) && (lhs != rhs) == (expected != 0));
+        CHECK((lhs < rhs) == (expected < 0) && (lhs > rhs) == (expected > 0));
+        CHECK((lhs <= rhs) == (expected <= 0) && (lhs >= rhs) == (expected >= 0));
+    }
+    CHECK(MismatchIndex("", "", 0) == 0);
+}
+
+void TestSearchMatchesStd() {
+    std::mt19937 generator(23);
+    const size_t kNpos = String::kNpos;
+    for (int round = 0; round < 300; ++round) {
+        const std::string text = RandomText(generator, generator() % 100, "abc");
+        const String str(text.c_str(), text.size());
+
+        std::vector<std::string> patterns{"", "a", "c", "ab", "cab", text};
+        if (!text.empty()) {
+            const size_t from = generator() % text.size();
+            patterns.push_back(text.substr(from, 1 + generator() % 9));
+            patterns.push_back(text.substr(0, 1 + generator() % text.size()));
+            patterns.push_back(text.substr(from));
+        }
+        patterns.push_back(text + "a");
+
+        for (size_t pos = 0; pos <= text.size() + 1; ++pos) {
+            for (const char symbol : {'a', 'b', 'c', 'd'}) {
+                CHECK(str.Find(symbol, pos) == text.find(symbol, pos));
+                CHECK(str.RFind(symbol, pos) == text.rfind(symbol, pos));
+            }
+            for (const std::string& pattern : patterns) {
+                const StringView view(pattern.c_str(), pattern.size());
+                CHECK(str.Find(view, pos) == text.find(pattern, pos));
+                CHECK(str.RFind(view, pos) == text.rfind(pattern, pos));
+            }
+        }
+        CHECK(str.Find('a', kNpos) == kNpos && str.Find("a", kNpos) == kNpos);
+        CHECK(str.RFind('a') == text.rfind('a') && str.RFind("ab") == text.rfind("ab"));
+    }
+}
+
+void TestSearchEdges() {
+    const String empty;
+    CHECK(empty.Find('a') == String::kNpos && empty.RFind('a') == String::kNpos);
+    CHECK(empty.Find("") == 0 && empty.RFind("") == 0);
+    CHECK(empty.Find("a") == String::kNpos && empty.RFind("a") == String::kNpos);
+
+    // matches at position 0 and ending at the last character
+    String text(64, '.');
+    text[0] = 'x';
+    text[1] = 'y';
+    text[62] = 'x';
+    text[63] = 'y';
+    CHECK(text.Find("xy") == 0 && text.Find("xy", 1) == 62 && text.Find("xy", 63) == String::kNpos);
+    CHECK(text.RFind("xy") == 62 && text.RFind("xy", 61) == 0 && text.RFind("xy", 0) == 0);
+    CHECK(text.Find('y', 2) == 63 && text.RFind('x', 61) == 0);
+    CHECK(text.Find("") == 0 && text.Find("", 64) == 64 && text.RFind("") == 64);
+    CHECK(text.Find(text) == 0 && text.RFind(text) == 0);
+}
+
+bool Holds(const Rope& rope, const std::string& expected) {
+    std::ostringstream out;
+    out << rope;
+    const String flat = rope.ToString();
+    bool same = rope.Size() == expected.size() && out.str() == expected
+                && std::string(flat.CStr(), flat.Size()) == expected;
+    for (size_t i = 0; same && i < expected.size(); i += 1 + expected.size() / 16) {
+        same = rope[i] == expected[i];
+    }
+    return same;
+}
+
+void TestRopeEmpty() {
+    Rope rope;
+    CHECK(rope.Empty() && Holds(rope, ""));
+    rope.Erase(0, 10);
+    rope.Insert(5, Rope());
+    rope += "";
+    CHECK(Holds(rope, "") && Holds(rope.Substr(0), "") && Holds(rope.Substr(3, 2), ""));
+    rope.Flatten();
+    CHECK(rope.Empty());
+
+    Rope text("text");
+    text.Insert(0, rope);
+    text += rope;
+    CHECK(Holds(text, "text"));
+    // positions past the end are clamped
+    text.Insert(100, Rope("!"));
+    text.Erase(3, 100);
+    CHECK(Holds(text, "tex") && Holds(text.Substr(100), ""));
+}
+
+// random edits against std::string, with copies taken along the way that
+// must not see the later edits
+void TestRopeMatchesStd() {
+    std::mt19937 generator(29);
+    Rope rope;
+    std::string expected;
+    std::vector<std::pair<Rope, std::string>> snapshots;
+
+    for (int step = 0; step < 3000; ++step) {
+        const size_t pos = generator() % (expected.size() + 2);
+        switch (generator() % 7) {
+            case 0: {
+                const char symbol = static_cast<char>('a' + generator() % 26);
+                rope += symbol;
+                expected += symbol;
+                break;
+            }
+            case 1: {
+                const std::string text = RandomText(generator, generator() % 40, "xyz");
+                rope.Append(text.c_str(), text.size());
+                expected += text;
+                break;
+            }
+            case 2: {
+                const std::string text = RandomText(generator, generator() % 2000, "pq");
+                rope.Insert(pos, Rope(text.c_str(), text.size()));
+                expected.insert(std::min(pos, expected.size()), text);
+                break;
+            }
+            case 3: {
+                const size_t count = generator() % 300;
+                rope.Erase(pos, count);
+                if (pos < expected.size()) {
+                    expected.erase(pos, count);
+                }
+                break;
+            }
+            case 4: {
+                const size_t count = generator() % 500;
+                const Rope part = rope.Substr(pos, count);
+                const std::string part_text = pos < expected.size() ? expected.substr(pos, count) : "";
+                CHECK(Holds(part, part_text));
+                const size_t at = generator() % (expected.size() + 1);
+                rope.Insert(at, part);
+                expected.insert(at, part_text);
+                break;
+            }
+            case 5:
+                snapshots.emplace_back(rope, expected);
+                break;
+            default:
+                if (expected.size() > 20000) {
+                    rope = rope.Substr(expected.size() / 2);
+                    expected = expected.substr(expected.size() / 2);
+                }
+                break;
+        }
+        if (step % 100 == 0) {
+            CHECK(Holds(rope, expected));
+        }
+    }
+    CHECK(Holds(rope, expected));
+    for (const auto& snapshot : snapshots) {
+        CHECK(Holds(snapshot.first, snapshot.second));
+    }
+}
+
+void TestRopeSharing() {
+    Rope base("shared piece");
+    Rope copy(base);
+    // small appends to one copy must not show through the other
+    copy += '!';
+    base += '?';
+    CHECK(Holds(base, "shared piece?") && Holds(copy, "shared piece!"));
+
+    Rope self("ab");
+    self.Insert(1, self);
+    CHECK(Holds(self, "aabb"));
+    self += self;
+    CHECK(Holds(self, "aabbaabb"));
+
+    Rope joined = Rope("left ") + Rope(String("right"));
+    joined.Flatten();
+    CHECK(Holds(joined, "left right"));
+    Rope moved(std::move(joined));
+    CHECK(Holds(moved, "left right") && joined.Empty());
+    moved.Swap(joined);
+    CHECK(Holds(joined, "left right") && moved.Empty());
+    joined.Clear();
+    CHECK(Holds(joined, ""));
+}
+
+// copies of one rope edited and dropped on separate threads; they share
+// every node and the buffer of the last piece when the threads start
+void TestRopeCopiesAcrossThreads() {
+    for (int round = 0; round < 20; ++round) {
+        Rope base;
+        std::string base_text;
+        for (int i = 0; i < 100; ++i) {
+            base += static_cast<char>('a' + i % 26);
+            base_text += static_cast<char>('a' + i % 26);
+        }
+        std::vector<Rope> copies(4, base);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&copies, t] {
+                Rope mine = std::move(copies[t]);
+                for (int i = 0; i < 50; ++i) {
+                    mine += static_cast<char>('0' + t);
+                }
+                mine.Insert(10, Rope("x"));
+                mine.Erase(0, 5);
+                copies[t] = mine;
+            });
+        }
+        base += "base";
+        base.Clear();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (int t = 0; t < 4; ++t) {
+            std::string expected = base_text + std::string(50, static_cast<char>('0' + t));
+            expected.insert(10, "x");
+            expected.erase(0, 5);
+            CHECK(Holds(copies[t], expected));
+        }
+    }
+}
+
+void TestStringPoolEmpty() {
+    StringPool pool(1);
+    CHECK(pool.Size() == 0 && pool.ShardCount() == 1);
+    const InternedString none;
+    CHECK(none.Empty() && none.Size() == 0 && Holds(none.ToString(), ""));
+    // every empty string is the default handle and takes no entry
+    CHECK(pool.Intern("") == none && pool.Intern(String()) == none && pool.Intern(StringView()) == none);
+    CHECK(pool.Size() == 0);
+    CHECK(StringPool(5).ShardCount() == 8 && StringPool(0).ShardCount() == 1);
+}
+
+// one shard, so its table grows several times; entries must not move
+void TestStringPoolGrowth() {
+    StringPool pool(1);
+    std::vector<InternedString> handles;
+    std::vector<const char*> data;
+    for (int i = 0; i < 1000; ++i) {
+        handles.push_back(pool.Intern(std::to_string(i).c_str()));
+        data.push_back(handles.back().Data());
+        CHECK(pool.Size() == static_cast<size_t>(i + 1));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        const std::string text = std::to_string(i);
+        const InternedString again = pool.Intern(StringView(text.c_str(), text.size()));
+        CHECK(again == handles[i] && again.Data() == data[i]);
+        CHECK(std::strcmp(again.CStr(), text.c_str()) == 0 && again.Size() == text.size());
+        CHECK(again.Hash() == HashBytes(text.c_str(), text.size()));
+        CHECK(Hash64<InternedString>()(again) == again.Hash());
+    }
+    CHECK(handles[1] != handles[10] && pool.Size() == 1000);
+
+    // interned by value, not by pointer; embedded zeros count
+    const String owned("0");
+    CHECK(pool.Intern(owned) == handles[0]);
+    const char with_zero[] = {'1', '\0', '2'};
+    const InternedString zero = pool.Intern(with_zero, 3);
+    CHECK(zero != handles[1] && zero.Size() == 3 && StringView(zero) == StringView(with_zero, 3));
+}
+
+void TestStringPoolThreads() {
+    const int kThreads = 4;
+    const int kStrings = 2000;
+    StringPool pool(8);
+    std::vector<std::vector<InternedString>> handles(kThreads);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&pool, &handles, t] {
+            // the threads meet on the same strings in different orders
+            for (int i = 0; i < kStrings; ++i) {
+                const int value = t % 2 == 0 ? i : kStrings - 1 - i;
+                handles[t].push_back(pool.Intern(("key-" + std::to_string(value)).c_str()));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(pool.Size() == static_cast<size_t>(kStrings));
+    for (int t = 0; t < kThreads; ++t) {
+        for (int i = 0; i < kStrings; ++i) {
+            const int value = t % 2 == 0 ? i : kStrings - 1 - i;
+            CHECK(handles[t][i] == handles[0][value]);
+        }
+    }
+}
+
+void TestStringViewSlicing() {
+    const StringView empty;
+    CHECK(empty.Empty() && empty.Size() == 0 && empty.Data() != nullptr);
+    CHECK(empty.Substr(0).Empty() && empty.Substr(5, 5).Empty());
+    CHECK(empty.StartsWith("") && empty.EndsWith("") && !empty.StartsWith('a') && !empty.EndsWith('a'));
+
+    const char text[] = "hello, world";
+    const StringView view(text);
+    CHECK(view.Size() == 12 && view.Front() == 'h' && view.Back() == 'd' && view[5] == ',');
+    CHECK(view.Substr(7) == "world" && view.Substr(0, 5) == "hello" && view.Substr(7, 100) == "world");
+    CHECK(view.Substr(12).Empty() && view.Substr(100).Empty() && view.Substr(3, 0).Empty());
+    // slicing points into the same characters
+    CHECK(view.Substr(7).Data() == text + 7);
+
+    StringView trimmed = view;
+    trimmed.RemovePrefix(7);
+    trimmed.RemoveSuffix(2);
+    CHECK(trimmed == "wor" && trimmed.Data() == text + 7);
+    trimmed.RemovePrefix(100);
+    CHECK(trimmed.Empty());
+    trimmed = view;
+    trimmed.RemoveSuffix(100);
+    CHECK(trimmed.Empty() && trimmed.Data() == text);
+
+    // not null-terminated: the view ends where its size says
+    const StringView part(text, 5);
+    CHECK(part == "hello" && part != "hello," && part.Find(',') == StringView::kNpos);
+    CHECK(part.EndsWith("llo") && part.EndsWith('o') && !part.EndsWith("hello,"));
+    CHECK(view.StartsWith("hello") && view.StartsWith('h') && !view.StartsWith("world"));
+    CHECK(view.EndsWith("world") && !view.EndsWith("hello, world!"));
+
+    std::string collected;
+    for (const char symbol : part) {
+        collected += symbol;
+    }
+    CHECK(collected == "hello");
+}
+
+void TestStringViewCompare() {
+    CHECK(StringView("abc").Compare("abc") == 0);
+    CHECK(StringView("abc").Compare("abd") < 0 && StringView("abd").Compare("abc") > 0);
+    CHECK(StringView("ab").Compare("abc") < 0 && StringView("abc").Compare("ab") > 0);
+    CHECK(StringView().Compare("") == 0 && StringView().Compare("a") < 0);
+    CHECK(StringView("a") < StringView("b") && StringView("b") > StringView("a"));
+    CHECK(StringView("a") <= StringView("a") && StringView("a") >= StringView("a"));
+
+    std::ostringstream out;
+    out << StringView("printed", 5);
+    CHECK(out.str() == "print");
+}
+
+void TestStringViewOverloads() {
+    const char text[] = "view text";
+    const StringView view(text, 4);
+    const String str(view);
+    CHECK(Holds(str, "view") && str.Data() != text);
+
+    // a String converts to a view of its own characters
+    const StringView of_str = str;
+    CHECK(of_str.Data() == str.Data() && of_str == "view");
+    CHECK(StringView(String()).Empty());
+
+    String built;
+    built += view;
+    built += StringView(text + 4, 5);
+    CHECK(Holds(built, "view text"));
+    CHECK(Holds(built + StringView("!"), "view text!"));
+    CHECK(Holds(String() + StringView(), ""));
+
+    // a view into the string itself, across the inline boundary
+    String doubled(20, 'd');
+    doubled += StringView(doubled);
+    CHECK(doubled.Size() == 40 && doubled.Find('e') == String::kNpos && doubled.Back() == 'd');
+
+    CHECK(built.Find(view) == 0 && built.Find(StringView("text")) == 5);
+    CHECK(StringView(built).Substr(5) == "text");
+}
+
+// hands out one character per call and keeps no get area
+class UnbufferedBuf : public std::streambuf {
+public:
+    explicit UnbufferedBuf(std::string text) : text_(std::move(text)) {
+    }
+
+protected:
+    int_type underflow() override {
+        return pos_ < text_.size() ? traits_type::to_int_type(text_[pos_]) : traits_type::eof();
+    }
+
+    int_type uflow() override {
+        return pos_ < text_.size() ? traits_type::to_int_type(text_[pos_++]) : traits_type::eof();
+    }
+
+private:
+    std::string text_;
+    size_t pos_ = 0;
+};
+
+std::string ReadInputText() {
+    return "  first\tsecond\n\n" + std::string(300, 'm') + " " + std::string(10000, 'L') + "\n" + "last";
+}
+
+// the same tokens from every kind of stream
+void CheckReadsInputText(std::istream& is) {
+    String word("previous contents that are replaced");
+    CHECK(is >> word && Holds(word, "first"));
+    CHECK(is >> word && Holds(word, "second"));
+    CHECK(is >> word && word.Size() == 300 && word.Find('m', 299) == 299 && word.Find(' ') == String::kNpos);
+    CHECK(is >> word && word.Size() == 10000 && word.Front() == 'L' && word.Back() == 'L');
+    CHECK(is >> word && Holds(word, "last") && is.eof() && !is.fail());
+    CHECK(!(is >> word) && is.fail());
+}
+
+void TestReadFromStringStream() {
+    std::istringstream is(ReadInputText());
+    CheckReadsInputText(is);
+
+    std::istringstream blank(" \n\t ");
+    String word("kept?");
+    CHECK(!(blank >> word) && blank.eof());
+
+    // width() bounds one extraction and is reset afterwards
+    std::istringstream wide("abcdefgh ij");
+    wide.width(3);
+    CHECK(wide >> word && Holds(word, "abc") && wide.width() == 0);
+    CHECK(wide >> word && Holds(word, "defgh"));
+    std::istringstream exact("0123456789abcdefghijklm|");
+    exact.width(String::kInlineCapacity);
+    CHECK(exact >> word && word.Size() == String::kInlineCapacity && word.Capacity() == String::kInlineCapacity);
+    CHECK(exact >> word && Holds(word, "|"));
+
+    // a token of exactly one chunk and one past it
+    for (const size_t size : {size_t(255), size_t(256), size_t(257), size_t(512)}) {
+        std::istringstream chunked(std::string(size, 'c') + " d");
+        CHECK(chunked >> word && word.Size() == size && word.Back() == 'c');
+        CHECK(chunked >> word && Holds(word, "d"));
+    }
+}
+
+void TestReadFromFile() {
+    const char* path = "test_strings_input.txt";
+    {
+        std::ofstream out(path);
+        out << ReadInputText();
+    }
+    std::ifstream in(path);
+    CHECK(in.is_open());
+    CheckReadsInputText(in);
+    in.close();
+    std::remove(path);
+}
+
+void TestReadUnbuffered() {
+    UnbufferedBuf buf(ReadInputText());
+    std::istream is(&buf);
+    CheckReadsInputText(is);
+}
+
+// std::cin synchronized with stdio keeps no buffer of its own
+void TestReadFromCin() {
+    const char* path = "test_strings_cin.txt";
+    {
+        std::ofstream out(path);
+        out << ReadInputText();
+    }
+    CHECK(std::freopen(path, "r", stdin) != nullptr);
+    CheckReadsInputText(std::cin);
+    std::remove(path);
+}
+
+int main() {
+    TestInlineBoundary();
+    TestMoves();
+    TestCopiesAndSwap();
+    TestCompareMatchesStd();
+    TestSearchMatchesStd();
+    TestSearchEdges();
+    TestRopeEmpty();
+    TestRopeMatchesStd();
+    TestRopeSharing();
+    TestRopeCopiesAcrossThreads();
+    TestStringPoolEmpty();
+    TestStringPoolGrowth();
+    TestStringPoolThreads();
+    TestStringViewSlicing();
+    TestStringViewCompare();
+    TestStringViewOverloads();
+    TestReadFromStringStream();
+    TestReadFromFile();
+    TestReadUnbuffered();
+    TestReadFromCin();
+    return 0;
+}
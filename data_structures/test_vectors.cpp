@@ -0,0 +1,504 @@
+#include "smallVector.h"
+#include "testCheck.h"
+#include "vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+int alive = 0;
+int copies = 0;
+int moves = 0;
+int copies_until_throw = -1;
+
+// counts its live instances, copies and moves; a copy throws once
+// copies_until_throw reaches zero
+template <bool NothrowMove>
+struct Counted {
+    std::string text_;
+
+    explicit Counted(std::string text) : text_(std::move(text)) {
+        ++alive;
+    }
+
+    Counted(const Counted& other) : text_(other.text_) {
+        if (copies_until_throw == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        --copies_until_throw;
+        ++copies;
+        ++alive;
+    }
+
+    Counted(Counted&& other) noexcept(NothrowMove) : text_(std::move(other.text_)) {
+        ++moves;
+        ++alive;
+    }
+
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) noexcept(NothrowMove) = default;
+
+    ~Counted() {
+        --alive;
+    }
+};
+
+using Movable = Counted<true>;
+using CopiedOnGrowth = Counted<false>;
+
+void ResetCounts() {
+    alive = 0;
+    copies = 0;
+    moves = 0;
+    copies_until_throw = -1;
+}
+
+std::string Text(int i) {
+    // long enough to live on the heap, so a bitwise relocation would show
+    return std::string(40, static_cast<char>('a' + i % 26)) + std::to_string(i);
+}
+
+void TestGrowthWithStrings() {
+    Vector<std::string> vector;
+    CHECK(vector.Empty() && vector.Capacity() == 0 && vector.Data() == nullptr);
+    for (int i = 0; i < 1000; ++i) {
+        vector.PushBack(Text(i));
+        CHECK(vector.Back() == Text(i));
+    }
+    CHECK(vector.Size() == 1000 && vector.Capacity() >= 1000);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK(vector[i] == Text(i));
+    }
+
+    Vector<std::string> copy(vector);
+    CHECK(copy == vector && copy.Capacity() == 1000);
+    copy.Resize(10);
+    copy.ShrinkToFit();
+    CHECK(copy.Capacity() == 10 && copy.Back() == Text(9));
+    copy.Resize(20, "filler");
+    CHECK(copy.Size() == 20 && copy[19] == "filler" && copy[9] == Text(9));
+
+    Vector<int> ints(5, 7);
+    ints.Reserve(100);
+    CHECK(ints.Capacity() == 100 && ints.Size() == 5 && ints[4] == 7);
+}
+
+// a type whose move cannot throw is moved into the new buffer, any other
+// copyable type is copied so the old buffer survives a failure
+void TestRelocationMovesOrCopies() {
+    ResetCounts();
+    {
+        Vector<Movable> vector;
+        vector.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            vector.EmplaceBack(Text(i));
+        }
+        vector.Reserve(8);
+        CHECK(moves == 4 && copies == 0 && alive == 4);
+        for (int i = 0; i < 4; ++i) {
+            CHECK(vector[i].text_ == Text(i));
+        }
+    }
+    CHECK(alive == 0);
+
+    ResetCounts();
+    {
+        Vector<CopiedOnGrowth> vector;
+        vector.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            vector.EmplaceBack(Text(i));
+        }
+        vector.Reserve(8);
+        CHECK(moves == 0 && copies == 4 && alive == 4);
+        for (int i = 0; i < 4; ++i) {
+            CHECK(vector[i].text_ == Text(i));
+        }
+    }
+    CHECK(alive == 0);
+}
+
+// a copy throwing halfway through a growth leaves the vector as it was and
+// destroys the copies already made
+void TestStrongGuarantee() {
+    ResetCounts();
+    {
+        Vector<CopiedOnGrowth> vector;
+        for (int i = 0; i < 8; ++i) {
+            vector.EmplaceBack(Text(i));
+        }
+        const CopiedOnGrowth* data = vector.Data();
+        const size_t capacity = vector.Capacity();
+
+        copies_until_throw = 3;
+        bool thrown = false;
+        try {
+            vector.Reserve(100);
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        CHECK(thrown && alive == 8);
+        CHECK(vector.Data() == data && vector.Capacity() == capacity && vector.Size() == 8);
+
+        copies_until_throw = 5;
+        thrown = false;
+        try {
+            vector.EmplaceBack(Text(8));
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        CHECK(thrown && alive == 8 && vector.Data() == data && vector.Size() == 8);
+        for (int i = 0; i < 8; ++i) {
+            CHECK(vector[i].text_ == Text(i));
+        }
+
+        copies_until_throw = -1;
+        vector.EmplaceBack(Text(8));
+        CHECK(vector.Size() == 9 && vector.Back().text_ == Text(8) && alive == 9);
+    }
+    CHECK(alive == 0);
+}
+
+// every element built is destroyed exactly once, whichever way it leaves
+void TestDestructionCounts() {
+    ResetCounts();
+    {
+        Vector<Movable> vector;
+        for (int i = 0; i < 100; ++i) {
+            vector.EmplaceBack(Text(i));
+        }
+        CHECK(alive == 100);
+        vector.PopBack();
+        vector.Resize(50, Movable("unused"));
+        CHECK(alive == 50 && vector.Size() == 50);
+
+        Vector<Movable> copy(vector);
+        CHECK(alive == 100);
+        Vector<Movable> moved(std::move(copy));
+        CHECK(alive == 100 && copy.Empty());
+        copy = vector;
+        CHECK(alive == 150);
+        copy.Clear();
+        CHECK(alive == 100 && copy.Empty());
+        moved.Swap(copy);
+        CHECK(moved.Empty() && copy.Size() == 50);
+        vector.ShrinkToFit();
+        CHECK(alive == 100 && vector.Capacity() == 50);
+    }
+    CHECK(alive == 0);
+}
+
+size_t allocations = 0;
+
+template <class T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>& /*other*/) {
+    }
+
+    T* allocate(size_t n) {
+        ++allocations;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    template <class U>
+    bool operator==(const CountingAllocator<U>& /*other*/) const {
+        return true;
+    }
+
+    template <class U>
+    bool operator!=(const CountingAllocator<U>& /*other*/) const {
+        return false;
+    }
+};
+
+// the argument is an element of the vector itself, and the call has to
+// grow the buffer that holds it
+void TestEmplaceBackAliasing() {
+    Vector<std::string> vector;
+    vector.PushBack(Text(0));
+    for (int i = 0; i < 6; ++i) {
+        while (vector.Size() < vector.Capacity()) {
+            vector.PushBack(Text(1));
+        }
+        vector.EmplaceBack(vector[0]);
+        CHECK(vector.Back() == Text(0) && vector[0] == Text(0));
+    }
+    while (vector.Size() < vector.Capacity()) {
+        vector.PushBack(Text(1));
+    }
+    vector.PushBack(vector.Back());
+    CHECK(vector.Back() == Text(1) && vector.Size() == 65);
+
+    ResetCounts();
+    {
+        Vector<Movable> movables;
+        movables.EmplaceBack(Text(1));
+        movables.EmplaceBack(movables[0]);
+        movables.EmplaceBack(movables[1]);
+        CHECK(movables.Size() == 3 && movables[2].text_ == Text(1) && alive == 3);
+    }
+    CHECK(alive == 0);
+}
+
+void TestAppend() {
+    // input iterators can only be walked once, so they grow as they go
+    std::istringstream input("1 2 3 4 5 6 7 8 9 10");
+    Vector<int> from_stream;
+    from_stream.PushBack(0);
+    from_stream.Append(std::istream_iterator<int>(input), std::istream_iterator<int>());
+    CHECK(from_stream.Size() == 11);
+    for (int i = 0; i <= 10; ++i) {
+        CHECK(from_stream[i] == i);
+    }
+
+    // forward iterators are counted first, then reserved for in one step
+    const std::list<std::string> words{"one", "two", Text(3), Text(4), Text(5)};
+    allocations = 0;
+    Vector<std::string, CountingAllocator<std::string>> vector;
+    vector.Append(words.begin(), words.end());
+    CHECK(allocations == 1 && vector.Size() == 5 && vector[2] == Text(3));
+    vector.Append(words.begin(), words.begin());
+    CHECK(allocations == 1 && vector.Size() == 5);
+
+    std::vector<std::string> many(100, Text(6));
+    vector.Append(many.begin(), many.end());
+    CHECK(allocations == 2 && vector.Size() == 105 && vector.Back() == Text(6));
+    CHECK(vector[4] == Text(5));
+
+    // small appends still grow geometrically
+    const size_t capacity = vector.Capacity();
+    while (vector.Size() < capacity) {
+        vector.Append(words.begin(), std::next(words.begin()));
+    }
+    vector.Append(words.begin(), std::next(words.begin()));
+    CHECK(allocations == 3 && vector.Capacity() >= 2 * capacity);
+}
+
+void TestInsert() {
+    const std::vector<std::string> base{Text(0), Text(1), Text(2), Text(3)};
+    const std::list<std::string> range{"x", "y", Text(9)};
+    for (size_t pos = 0; pos <= base.size(); ++pos) {
+        std::vector<std::string> expected = base;
+        expected.insert(expected.begin() + pos, range.begin(), range.end());
+
+        Vector<std::string> vector;
+        vector.Append(base.begin(), base.end());
+        vector.Insert(pos, range.begin(), range.end());
+        CHECK(vector.Size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            CHECK(vector[i] == expected[i]);
+        }
+
+        std::istringstream input("7 8");
+        const size_t int_pos = pos < 3 ? pos : 3;
+        std::vector<int> expected_ints{1, 2, 3};
+        Vector<int> ints;
+        ints.Append(expected_ints.begin(), expected_ints.end());
+        expected_ints.insert(expected_ints.begin() + int_pos, {7, 8});
+        ints.Insert(int_pos, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        CHECK(ints.Size() == 5);
+        for (size_t i = 0; i < 5; ++i) {
+            CHECK(ints[i] == expected_ints[i]);
+        }
+    }
+}
+
+void TestPushBackMoves() {
+    ResetCounts();
+    {
+        Vector<Movable> vector;
+        vector.Reserve(2);
+        Movable value(Text(0));
+        vector.PushBack(std::move(value));
+        CHECK(moves == 1 && copies == 0 && vector[0].text_ == Text(0));
+        vector.PushBack(Movable(Text(1)));
+        CHECK(moves == 2 && copies == 0 && alive == 3);
+        vector.PushBack(vector[0]);
+        CHECK(copies == 1 && vector.Back().text_ == Text(0));
+    }
+    CHECK(alive == 0);
+
+    Vector<std::string> strings;
+    std::string text = Text(5);
+    strings.PushBack(std::move(text));
+    CHECK(strings[0] == Text(5) && text.empty());
+}
+
+template <size_t N>
+SmallVector<std::string, N> SmallOf(int count) {
+    SmallVector<std::string, N> vector;
+    for (int i = 0; i < count; ++i) {
+        vector.PushBack(Text(i));
+    }
+    return vector;
+}
+
+template <size_t N>
+bool Holds(const SmallVector<std::string, N>& vector, int count) {
+    if (vector.Size() != static_cast<size_t>(count)) {
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (vector[i] != Text(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// N elements still fit inline, the next one moves everything to the heap
+void TestSmallVectorSpill() {
+    SmallVector<std::string, 4> vector;
+    CHECK(vector.IsSmall() && vector.Capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        vector.PushBack(Text(i));
+    }
+    CHECK(vector.IsSmall() && vector.Capacity() == 4 && Holds(vector, 4));
+    vector.PushBack(Text(4));
+    CHECK(!vector.IsSmall() && vector.Capacity() == 8 && Holds(vector, 5));
+
+    vector.PopBack();
+    vector.ShrinkToFit();
+    CHECK(vector.IsSmall() && Holds(vector, 4));
+
+    SmallVector<int, 4> ints;
+    const std::vector<int> values{1, 2, 3, 4, 5};
+    ints.Append(values.begin(), values.begin() + 4);
+    CHECK(ints.IsSmall());
+    ints.Insert(0, values.begin() + 4, values.end());
+    CHECK(!ints.IsSmall() && ints.Size() == 5 && ints[0] == 5 && ints[4] == 4);
+}
+
+// copies and moves between an inline and a heap vector, both ways
+void TestSmallVectorCopyMove() {
+    const SmallVector<std::string, 4> small = SmallOf<4>(3);
+    const SmallVector<std::string, 4> large = SmallOf<4>(10);
+
+    SmallVector<std::string, 4> target = SmallOf<4>(10);
+    target = small;
+    CHECK(Holds(target, 3) && Holds(small, 3));
+    target = large;
+    CHECK(!target.IsSmall() && Holds(target, 10) && Holds(large, 10));
+    target = small;
+    CHECK(Holds(target, 3));
+
+    SmallVector<std::string, 4> copied(large);
+    CHECK(!copied.IsSmall() && Holds(copied, 10));
+    SmallVector<std::string, 4> copied_small(small);
+    CHECK(copied_small.IsSmall() && Holds(copied_small, 3));
+
+    // a heap buffer is handed over, inline elements are moved one by one
+    SmallVector<std::string, 4> heap_source = SmallOf<4>(10);
+    const std::string* heap_data = heap_source.Data();
+    SmallVector<std::string, 4> moved(std::move(heap_source));
+    CHECK(moved.Data() == heap_data && Holds(moved, 10));
+    CHECK(heap_source.IsSmall() && heap_source.Empty());
+
+    SmallVector<std::string, 4> inline_source = SmallOf<4>(3);
+    SmallVector<std::string, 4> moved_small(std::move(inline_source));
+    CHECK(moved_small.IsSmall() && Holds(moved_small, 3) && inline_source.Empty());
+
+    // inline elements moved into a heap vector keep its buffer
+    moved = std::move(moved_small);
+    CHECK(moved.Data() == heap_data && Holds(moved, 3));
+    moved_small = SmallOf<4>(10);
+    CHECK(!moved_small.IsSmall() && Holds(moved_small, 10));
+
+    moved.Swap(moved_small);
+    CHECK(Holds(moved, 10) && Holds(moved_small, 3));
+    moved_small.Swap(moved);
+    CHECK(Holds(moved, 3) && Holds(moved_small, 10));
+}
+
+// the argument is one of the inline elements the call spills to the heap
+void TestSmallVectorEmplaceBackAliasing() {
+    SmallVector<std::string, 4> vector = SmallOf<4>(4);
+    vector.EmplaceBack(vector[0]);
+    CHECK(!vector.IsSmall() && vector.Size() == 5 && vector.Back() == Text(0));
+    vector.PopBack();
+    CHECK(Holds(vector, 4));
+
+    SmallVector<std::string, 1> single = SmallOf<1>(1);
+    single.PushBack(single.Back());
+    CHECK(single.Size() == 2 && single[0] == Text(0) && single[1] == Text(0));
+}
+
+struct alignas(128) Big {
+    int value_;
+};
+
+void TestSmallVectorOverAligned() {
+    SmallVector<Big, 1> vector;
+    for (int i = 0; i < 64; ++i) {
+        vector.PushBack(Big{i});
+        CHECK(reinterpret_cast<uintptr_t>(&vector[0]) % alignof(Big) == 0);
+    }
+    vector.Reserve(1000);
+    CHECK(reinterpret_cast<uintptr_t>(vector.Data()) % alignof(Big) == 0);
+    for (int i = 0; i < 64; ++i) {
+        CHECK(vector[i].value_ == i);
+    }
+    SmallVector<Big, 1> copy(vector);
+    CHECK(reinterpret_cast<uintptr_t>(copy.Data()) % alignof(Big) == 0 && copy[63].value_ == 63);
+}
+
+void TestSmallVectorDestructionCounts() {
+    ResetCounts();
+    {
+        SmallVector<Movable, 4> vector;
+        for (int i = 0; i < 20; ++i) {
+            vector.EmplaceBack(Text(i));
+        }
+        CHECK(alive == 20);
+        vector.Resize(3, Movable("unused"));
+        CHECK(alive == 3);
+        vector.ShrinkToFit();
+        CHECK(alive == 3 && vector.IsSmall());
+
+        SmallVector<Movable, 4> copy(vector);
+        copy.Resize(10, Movable("filler"));
+        CHECK(alive == 13);
+        SmallVector<Movable, 4> moved(std::move(copy));
+        CHECK(alive == 13 && copy.Empty());
+        moved = vector;
+        CHECK(alive == 6);
+        vector = std::move(moved);
+        CHECK(alive == 3);
+        vector.Clear();
+        CHECK(alive == 0);
+        vector.EmplaceBack("last");
+    }
+    CHECK(alive == 0);
+}
+
+int main() {
+    TestGrowthWithStrings();
+    TestRelocationMovesOrCopies();
+    TestStrongGuarantee();
+    TestDestructionCounts();
+    TestEmplaceBackAliasing();
+    TestAppend();
+    TestInsert();
+    TestPushBackMoves();
+    TestSmallVectorSpill();
+    TestSmallVectorCopyMove();
+    TestSmallVectorEmplaceBackAliasing();
+    TestSmallVectorOverAligned();
+    TestSmallVectorDestructionCounts();
+    return 0;
+}
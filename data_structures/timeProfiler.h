@@ -0,0 +1,21 @@
+#ifndef TIMEPROFILER_H
+#define TIMEPROFILER_H
+
+#include <ctime>
+#include <iostream>
+
+class TimeProfiler {
+    const char* info_;
+    clock_t start_;
+    std::ostream& out_;
+public:
+    explicit TimeProfiler(const char* info, std::ostream& out = std::cout) : info_(info), start_(clock()), out_(out) {
+    }
+
+    ~TimeProfiler() {
+        auto end = clock();
+        out_ << info_ << ": " << static_cast<double>(end - start_) / CLOCKS_PER_SEC << '\n';
+    }
+};
+
+#endif //TIMEPROFILER_H
@@ -0,0 +1,296 @@
+#ifndef UNROLLEDFORWARDLIST_H
+#define UNROLLEDFORWARDLIST_H
+
+#include "lockedShard.h"
+#include "nodePool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// elements per node so that a node of small values fills one cache line;
+// large values still get a few per node
+template <typename T>
+constexpr size_t DefaultUnrolledCapacity() {
+    const size_t kHeader = sizeof(void*) + sizeof(size_t);
+    const size_t fit = kCacheLineSize > kHeader + sizeof(T) ? (kCacheLineSize - kHeader) / sizeof(T) : 0;
+    return fit < 4 ? 4 : fit;
+}
+
+// starts on a cache line, so a node that fits in one never straddles two
+template <typename T, size_t K>
+struct alignas(kCacheLineSize) UnrolledNode {
+    UnrolledNode* next_;
+    // the node holds its values in slots [K - count_, K)
+    size_t count_;
+    alignas(T) unsigned char storage_[K * sizeof(T)];
+
+    explicit UnrolledNode(UnrolledNode* next) : next_(next), count_(0) {
+    }
+
+    T* Slot(const size_t idx) {
+        return std::launder(reinterpret_cast<T*>(storage_) + idx);
+    }
+
+    size_t First() const {
+        return K - count_;
+    }
+};
+
+// ForwardList that packs up to K values into every node, so a scan chases
+// one pointer per K values instead of one per value. Values are added to
+// the head node from its back, which keeps push_front and pop_front O(1);
+// only the head node is partly filled until reverse() moves it.
+template <typename T, size_t K = DefaultUnrolledCapacity<T>(), class Allocator = std::allocator<T>>
+class UnrolledForwardList {
+    static_assert(K > 0, "a node must hold at least one value");
+
+    using NodeType = UnrolledNode<T, K>;
+    using NodeAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType>;
+    using NodeTraits = std::allocator_traits<NodeAlloc>;
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using allocator_type = Allocator;
+
+    static constexpr size_t kNodeCapacity = K;
+
+    class Iterator {
+    public:
+        Iterator() = default;
+
+        Iterator(NodeType* node) : node_(node), idx_(node == nullptr ? 0 : node->First()) {
+        }
+
+        Iterator& operator++() {
+            if (++idx_ == K) {
+                node_ = node_->next_;
+                idx_ = node_ == nullptr ? 0 : node_->First();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        T& operator*() {
+            return *node_->Slot(idx_);
+        }
+
+        const T& operator*() const {
+            return *node_->Slot(idx_);
+        }
+
+        T* operator->() {
+            return node_->Slot(idx_);
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return node_ != other.node_ || idx_ != other.idx_;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return !(*this != other);
+        }
+
+    private:
+        NodeType* node_;
+        size_t idx_;
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    UnrolledForwardList() : UnrolledForwardList(Allocator()) {
+    }
+
+    explicit UnrolledForwardList(const Allocator& alloc) : alloc_(alloc), size_(0), head_(nullptr) {
+    }
+
+    UnrolledForwardList(const size_t size, const T& value, const Allocator& alloc = Allocator())
+            : UnrolledForwardList(alloc) {
+        for (size_t i = 0; i < size; ++i) {
+            push_front(value);
+        }
+    }
+
+    UnrolledForwardList(std::initializer_list<T> i_list, const Allocator& alloc = Allocator())
+            : UnrolledForwardList(alloc) {
+        for (auto it = std::rbegin(i_list); it != std::rend(i_list); ++it) {
+            push_front(*it);
+        }
+    }
+
+    UnrolledForwardList(const UnrolledForwardList& other)
+            : UnrolledForwardList(NodeTraits::select_on_container_copy_construction(other.alloc_)) {
+        CopyNodes(other);
+    }
+
+    UnrolledForwardList& operator=(const UnrolledForwardList& other) {
+        UnrolledForwardList(other).Swap(*this);
+        return *this;
+    }
+
+    UnrolledForwardList(UnrolledForwardList&& other) noexcept : UnrolledForwardList(other.alloc_) {
+        Swap(other);
+    }
+
+    UnrolledForwardList& operator=(UnrolledForwardList&& other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~UnrolledForwardList() {
+        clear();
+    }
+
+    iterator begin() {
+        return iterator(head_);
+    }
+
+    iterator end() {
+        return iterator(nullptr);
+    }
+
+    const_iterator cbegin() const {
+        return iterator(head_);
+    }
+
+    const_iterator cend() const {
+        return iterator(nullptr);
+    }
+
+    // reverses the order of the nodes and of the values inside each of them
+    void reverse() {
+        NodeType* curr = head_;
+        NodeType* prev = nullptr;
+
+        while (curr) {
+            NodeType* next = curr->next_;
+            std::reverse(curr->Slot(curr->First()), curr->Slot(K));
+            curr->next_ = prev;
+            prev = curr;
+            curr = next;
+        }
+
+        head_ = prev;
+    }
+
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+
+    template <class... Args>
+    void emplace_front(Args&& ... args) {
+        const bool new_node = head_ == nullptr || head_->count_ == K;
+        if (new_node) {
+            head_ = CreateNode(head_);
+        }
+        try {
+            NodeTraits::construct(alloc_, head_->Slot(head_->First() - 1), std::forward<Args>(args)...);
+        } catch (...) {
+            if (new_node) {
+                NodeType* next = head_->next_;
+                DestroyNode(head_);
+                head_ = next;
+            }
+            throw;
+        }
+        ++head_->count_;
+        ++size_;
+    }
+
+    void pop_front() {
+        if (size_ != 0) {
+            NodeTraits::destroy(alloc_, head_->Slot(head_->First()));
+            --size_;
+            if (--head_->count_ == 0) {
+                NodeType* next = head_->next_;
+                DestroyNode(head_);
+                head_ = next;
+            }
+        }
+    }
+
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (NodeType* node = head_; node != nullptr; node = node->next_) {
+                for (size_t i = node->First(); i < K; ++i) {
+                    NodeTraits::destroy(alloc_, node->Slot(i));
+                }
+            }
+        }
+        head_ = nullptr;
+        size_ = 0;
+        pool_.Release(alloc_);
+    }
+
+    T& front() {
+        return *head_->Slot(head_->First());
+    }
+
+    const T& front() const {
+        return *head_->Slot(head_->First());
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(alloc_);
+    }
+
+private:
+    NodeAlloc alloc_;
+    NodePool<NodeType, NodeAlloc> pool_;
+    size_t size_;
+    NodeType* head_;
+
+    void Swap(UnrolledForwardList& other) {
+        std::swap(alloc_, other.alloc_);
+        pool_.Swap(other.pool_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    NodeType* CreateNode(NodeType* next) {
+        NodeType* node = pool_.Allocate(alloc_);
+        return new (node) NodeType(next);
+    }
+
+    // the values must already be destroyed
+    void DestroyNode(NodeType* node) {
+        node->~NodeType();
+        pool_.Deallocate(node);
+    }
+
+    // copies node by node, so the copy has the same layout as other
+    void CopyNodes(const UnrolledForwardList& other) {
+        NodeType** tail = &head_;
+        for (NodeType* source = other.head_; source != nullptr; source = source->next_) {
+            NodeType* node = CreateNode(nullptr);
+            *tail = node;
+            tail = &node->next_;
+            for (size_t i = K; i > source->First(); --i) {
+                NodeTraits::construct(alloc_, node->Slot(i - 1), *source->Slot(i - 1));
+                ++node->count_;
+                ++size_;
+            }
+        }
+    }
+};
+
+#endif //UNROLLEDFORWARDLIST_H
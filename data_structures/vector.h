@@ -2,6 +2,13 @@
 #define VECTOR_H
 
 #include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 template <class T>
 void SwapArgs(T& a, T& b) {
@@ -10,76 +17,259 @@ void SwapArgs(T& a, T& b) {
     b = temp;
 }
 
-template <class T>
-static void CopyBuffers(const T* from, T* to, size_t amount) {
-    for (size_t i = 0; i < amount; ++i) {
-        to[i] = from[i];
+template <class Alloc, class T, class = void>
+struct HasConstructMember : std::false_type {
+};
+
+template <class Alloc, class T>
+struct HasConstructMember<Alloc, T, std::void_t<decltype(std::declval<Alloc&>().construct(std::declval<T*>()))>>
+        : std::true_type {
+};
+
+template <class Alloc, class T, class = void>
+struct HasDestroyMember : std::false_type {
+};
+
+template <class Alloc, class T>
+struct HasDestroyMember<Alloc, T, std::void_t<decltype(std::declval<Alloc&>().destroy(std::declval<T*>()))>>
+        : std::true_type {
+};
+
+// false when Alloc builds or destroys values its own way, in which case even
+// trivial values have to go through allocator_traits one at a time;
+// std::allocator still declares both members in C++17 but does nothing special
+template <class Alloc, class T>
+constexpr bool kPlainConstruction = std::is_same_v<Alloc, std::allocator<T>>
+        || (!HasConstructMember<Alloc, T>::value && !HasDestroyMember<Alloc, T>::value);
+
+template <class Alloc, class T>
+static void DestroyRange(Alloc& alloc, T* first, T* last) {
+    if constexpr (!std::is_trivially_destructible_v<T> || !kPlainConstruction<Alloc, T>) {
+        for (; first != last; ++first) {
+            std::allocator_traits<Alloc>::destroy(alloc, first);
+        }
     }
 }
 
-template <class T>
-static void FillWith(const T& value, size_t size, T* array) {
-    for (size_t i = 0; i < size; ++i) {
-        array[i] = value;
+// constructs copies of from[0, amount) in the raw memory at to,
+// destroying the already built prefix if one of the copies throws
+template <class Alloc, class T>
+static void CopyBuffers(Alloc& alloc, const T* from, T* to, size_t amount) {
+    if constexpr (std::is_trivially_copyable_v<T> && kPlainConstruction<Alloc, T>) {
+        if (amount > 0) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), amount * sizeof(T));
+        }
+    } else {
+        size_t i = 0;
+        try {
+            for (; i < amount; ++i) {
+                std::allocator_traits<Alloc>::construct(alloc, to + i, from[i]);
+            }
+        } catch (...) {
+            DestroyRange(alloc, to, to + i);
+            throw;
+        }
     }
 }
 
-template <class T>
+// moves from[0, amount) into the raw memory at to; falls back to copying
+// when T's move constructor may throw, so a failed growth leaves from intact
+template <class Alloc, class T>
+static void RelocateBuffers(Alloc& alloc, T* from, T* to, size_t amount) {
+    if constexpr (std::is_trivially_copyable_v<T> && kPlainConstruction<Alloc, T>) {
+        if (amount > 0) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), amount * sizeof(T));
+        }
+    } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        size_t i = 0;
+        try {
+            for (; i < amount; ++i) {
+                std::allocator_traits<Alloc>::construct(alloc, to + i, std::move(from[i]));
+            }
+        } catch (...) {
+            DestroyRange(alloc, to, to + i);
+            throw;
+        }
+    } else {
+        CopyBuffers(alloc, from, to, amount);
+    }
+}
+
+template <class Alloc, class T>
+static void ValueInit(Alloc& alloc, size_t size, T* array) {
+    size_t i = 0;
+    try {
+        for (; i < size; ++i) {
+            std::allocator_traits<Alloc>::construct(alloc, array + i);
+        }
+    } catch (...) {
+        DestroyRange(alloc, array, array + i);
+        throw;
+    }
+}
+
+template <class Alloc, class T>
+static void FillWith(Alloc& alloc, const T& value, size_t size, T* array) {
+    size_t i = 0;
+    try {
+        for (; i < size; ++i) {
+            std::allocator_traits<Alloc>::construct(alloc, array + i, value);
+        }
+    } catch (...) {
+        DestroyRange(alloc, array, array + i);
+        throw;
+    }
+}
+
+template <class T, class Allocator = std::allocator<T>>
 class Vector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
-    Vector() : size_(0), capacity_(0), buffer_(nullptr) {
+    using allocator_type = Allocator;
+
+    Vector() : Vector(Allocator()) {
     }
 
-    explicit Vector(size_t size) : size_(size), capacity_(size) {
-        buffer_ = new T[capacity_]();
+    explicit Vector(const Allocator& alloc) : alloc_(alloc), buffer_(nullptr), size_(0), capacity_(0) {
     }
 
-    Vector(size_t size, const T& value) : Vector(size) {
-        FillWith(value, size_, buffer_);
+    explicit Vector(size_t size, const Allocator& alloc = Allocator()) : Vector(alloc) {
+        Resize(size);
     }
 
-    Vector(const Vector& other) : size_(other.size_), capacity_(other.capacity_) {
-        buffer_ = new T[capacity_];
-        CopyBuffers(other.buffer_, buffer_, size_);
+    Vector(size_t size, const T& value, const Allocator& alloc = Allocator()) : Vector(alloc) {
+        Resize(size, value);
     }
 
-    Vector& operator=(Vector other) {
+    Vector(const Vector& other) : Vector(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+        buffer_ = Allocate(other.size_);
+        capacity_ = other.size_;
+        CopyBuffers(alloc_, other.buffer_, buffer_, other.size_);
+        size_ = other.size_;
+    }
+
+    Vector(Vector&& other) noexcept : Vector(other.alloc_) {
+        Swap(other);
+    }
+
+    // the allocator travels with the buffer, so assignment propagates it
+    Vector& operator=(Vector other) noexcept {
         Swap(other);
         return *this;
     }
 
     ~Vector() {
-        delete[] buffer_;
+        DestroyRange(alloc_, buffer_, buffer_ + size_);
+        Deallocate(buffer_, capacity_);
     }
 
     void Clear() {
+        DestroyRange(alloc_, buffer_, buffer_ + size_);
         size_ = 0;
     }
 
     void PushBack(const T& value) {
-        if (size_ >= capacity_) {
-            Reallocate(IncreasedCapacity());
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    template <class... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ < capacity_) {
+            AllocTraits::construct(alloc_, buffer_ + size_, std::forward<Args>(args)...);
+        } else {
+            // the new element is built before the old ones are relocated,
+            // so args may still refer to elements of this vector
+            const size_t new_capacity = IncreasedCapacity();
+            T* tmpBuffer = Allocate(new_capacity);
+            try {
+                AllocTraits::construct(alloc_, tmpBuffer + size_, std::forward<Args>(args)...);
+            } catch (...) {
+                Deallocate(tmpBuffer, new_capacity);
+                throw;
+            }
+            try {
+                RelocateBuffers(alloc_, buffer_, tmpBuffer, size_);
+            } catch (...) {
+                AllocTraits::destroy(alloc_, tmpBuffer + size_);
+                Deallocate(tmpBuffer, new_capacity);
+                throw;
+            }
+            DestroyRange(alloc_, buffer_, buffer_ + size_);
+            Deallocate(buffer_, capacity_);
+            buffer_ = tmpBuffer;
+            capacity_ = new_capacity;
         }
+        return buffer_[size_++];
+    }
 
-        buffer_[size_++] = value;
+    // appends [first, last); the range must not point into this vector
+    template <class InputIt>
+    void Append(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            const size_t count = std::distance(first, last);
+            ReserveForAppend(count);
+            size_t built = 0;
+            try {
+                for (; built < count; ++built, ++first) {
+                    AllocTraits::construct(alloc_, buffer_ + size_ + built, *first);
+                }
+            } catch (...) {
+                DestroyRange(alloc_, buffer_ + size_, buffer_ + size_ + built);
+                throw;
+            }
+            size_ += count;
+        } else {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    // inserts [first, last) before the element at index pos;
+    // the range must not point into this vector
+    template <class InputIt>
+    void Insert(size_t pos, InputIt first, InputIt last) {
+        const size_t old_size = size_;
+        Append(first, last);
+        std::rotate(buffer_ + pos, buffer_ + old_size, buffer_ + size_);
     }
 
     void PopBack() {
         if (!Empty()) {
             --size_;
+            AllocTraits::destroy(alloc_, buffer_ + size_);
         }
     }
 
     void Resize(size_t new_size) {
-        Resize(new_size, T());
+        if (new_size > size_) {
+            if (new_size > capacity_) {
+                Reallocate(new_size);
+            }
+            ValueInit(alloc_, new_size - size_, buffer_ + size_);
+        } else {
+            DestroyRange(alloc_, buffer_ + new_size, buffer_ + size_);
+        }
+        size_ = new_size;
     }
 
     void Resize(size_t new_size, const T& value) {
-        if (new_size > size_ && new_size > capacity_) {
-            Reallocate(new_size);
-            FillWith(value, new_size - size_, buffer_ + size_);
-        } else if (new_size > size_ && new_size <= capacity_) {
-            FillWith(value, new_size - size_, buffer_ + size_);
+        if (new_size > size_) {
+            if (new_size > capacity_) {
+                T tmp(value);
+                Reallocate(new_size);
+                FillWith(alloc_, tmp, new_size - size_, buffer_ + size_);
+            } else {
+                FillWith(alloc_, value, new_size - size_, buffer_ + size_);
+            }
+        } else {
+            DestroyRange(alloc_, buffer_ + new_size, buffer_ + size_);
         }
         size_ = new_size;
     }
@@ -96,10 +286,15 @@ public:
         }
     }
 
-    void Swap(Vector& other) {
+    void Swap(Vector& other) noexcept {
         SwapArgs(size_, other.size_);
         SwapArgs(capacity_, other.capacity_);
         SwapArgs(buffer_, other.buffer_);
+        SwapArgs(alloc_, other.alloc_);
+    }
+
+    Allocator GetAllocator() const {
+        return alloc_;
     }
 
     T& operator[](size_t idx) {
@@ -147,20 +342,48 @@ public:
     }
 
 private:
+    Allocator alloc_;
     T* buffer_;
     size_t size_;
     size_t capacity_;
 
     static const size_t kIncreasefactor = 2;
 
+    T* Allocate(size_t capacity) {
+        if (capacity == 0) {
+            return nullptr;
+        }
+        return AllocTraits::allocate(alloc_, capacity);
+    }
+
+    void Deallocate(T* buffer, size_t capacity) {
+        if (buffer != nullptr) {
+            AllocTraits::deallocate(alloc_, buffer, capacity);
+        }
+    }
+
+    // strong guarantee: if relocating throws, the vector is left untouched
     void Reallocate(size_t new_capacity) {
-        T* tmpBuffer = new T[new_capacity];
-        CopyBuffers(buffer_, tmpBuffer, size_);
-        delete[] buffer_;
+        T* tmpBuffer = Allocate(new_capacity);
+        try {
+            RelocateBuffers(alloc_, buffer_, tmpBuffer, size_);
+        } catch (...) {
+            Deallocate(tmpBuffer, new_capacity);
+            throw;
+        }
+        DestroyRange(alloc_, buffer_, buffer_ + size_);
+        Deallocate(buffer_, capacity_);
         buffer_ = tmpBuffer;
         capacity_ = new_capacity;
     }
 
+    // grows at least geometrically so that repeated appends stay amortized O(1)
+    void ReserveForAppend(size_t count) {
+        if (size_ + count > capacity_) {
+            Reallocate(std::max(size_ + count, IncreasedCapacity()));
+        }
+    }
+
     size_t IncreasedCapacity() {
         if (capacity_ == 0) {
             return 1;
@@ -170,8 +393,8 @@ private:
     }
 };
 
-template <class T>
-static int Compare(const Vector<T>& lhs, const Vector<T>& rhs) {
+template <class T, class Allocator>
+static int Compare(const Vector<T, Allocator>& lhs, const Vector<T, Allocator>& rhs) {
     for (size_t i = 0; i < lhs.Size() && i < rhs.Size(); ++i) {
         if (lhs[i] > rhs[i]) {
             return 1;
@@ -189,33 +412,33 @@ static int Compare(const Vector<T>& lhs, const Vector<T>& rhs) {
     }
 }
 
-template <class T>
-bool operator==(const Vector<T>& lhs, const Vector<T>& rhs) {
+template <class T, class Allocator>
+bool operator==(const Vector<T, Allocator>& lhs, const Vector<T, Allocator>& rhs) {
     return Compare(lhs, rhs) == 0;
 }
 
-template <class T>
-bool operator!=(const Vector<T>& lhs, const Vector<T>& rhs) {
+template <class T, class Allocator>
+bool operator!=(const Vector<T, Allocator>& lhs, const Vector<T, Allocator>& rhs) {
     return !(lhs == rhs);
 }
 
-template <class T>
-bool operator>(const Vector<T>& lhs, const Vector<T>& rhs) {
+template <class T, class Allocator>
+bool operator>(const Vector<T, Allocator>& lhs, const Vector<T, Allocator>& rhs) {
     return Compare(lhs, rhs) > 0;
 }
 
-template <class T>
-bool operator<=(const Vector<T>& lhs, const Vector<T>& rhs) {
+template <class T, class Allocator>
+bool operator<=(const Vector<T, Allocator>& lhs, const Vector<T, Allocator>& rhs) {
     return !(lhs > rhs);
 }
 
-template <class T>
-bool operator<(const Vector<T>& lhs, const Vector<T>& rhs) {
+template <class T, class Allocator>
+bool operator<(const Vector<T, Allocator>& lhs, const Vector<T, Allocator>& rhs) {
     return rhs > lhs;
 }
 
-template <class T>
-bool operator>=(const Vector<T>& lhs, const Vector<T>& rhs) {
+template <class T, class Allocator>
+bool operator>=(const Vector<T, Allocator>& lhs, const Vector<T, Allocator>& rhs) {
     return !(lhs < rhs);
 }
 
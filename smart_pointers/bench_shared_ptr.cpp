@@ -0,0 +1,134 @@
+#include "intrusive_ptr.h"
+#include "shared_ptr.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// million copy-and-drop pairs per second over all threads, every thread
+// hammering the counter of the same object
+template <class Pointer>
+double CopyThroughput(const Pointer& shared, size_t threads, size_t ops_per_thread) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([mine = shared, ops_per_thread]() {
+            long sum = 0;
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                Pointer copy = mine;
+                sum += *copy;
+            }
+            if (sum < 0) {
+                std::cout << sum;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(threads * ops_per_thread) / elapsed.count() / 1e6;
+}
+
+// the same with every copy taken from a weak pointer
+template <class Weak>
+double LockThroughput(const Weak& weak, size_t threads, size_t ops_per_thread) {
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([mine = weak, ops_per_thread]() {
+            long sum = 0;
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+                sum += *mine.lock();
+            }
+            if (sum < 0) {
+                std::cout << sum;
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(threads * ops_per_thread) / elapsed.count() / 1e6;
+}
+
+struct Payload {
+    long values[4] = {1, 2, 3, 4};
+};
+
+struct CountedPayload : RefCounted<CountedPayload> {
+    long values[4] = {1, 2, 3, 4};
+};
+
+// million objects built, read through the pointer and destroyed per second
+template <class Make>
+double CreateThroughput(Make make, size_t ops) {
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        auto pointer = make();
+        sum += pointer->values[i % 4];
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (sum < 0) {
+        std::cout << sum;
+    }
+    return static_cast<double>(ops) / elapsed.count() / 1e6;
+}
+
+// WeakPtr spells it Lock
+template <class T, class Policy>
+struct LockAdapter {
+    WeakPtr<T, Policy> weak_;
+
+    SharedPtr<T, Policy> lock() const {
+        return weak_.Lock();
+    }
+};
+
+int main() {
+    const size_t kOps = 20'000'000;
+
+    SharedPtr<int> shared(new int(1));
+    LocalSharedPtr<int> local(new int(1));
+    std::shared_ptr<int> standard = std::make_shared<int>(1);
+
+    std::cout << "copy + drop on one thread, Mops/s\n";
+    std::cout << "    SharedPtr:       " << CopyThroughput(shared, 1, kOps) << '\n';
+    std::cout << "    LocalSharedPtr:  " << CopyThroughput(local, 1, kOps) << '\n';
+    std::cout << "    std::shared_ptr: " << CopyThroughput(standard, 1, kOps) << '\n';
+
+    const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+    std::cout << "copy + drop of one object, Mops/s (SharedPtr / std::shared_ptr)\n";
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << "    " << threads << " threads: "
+                  << CopyThroughput(shared, threads, kOps / threads) << " / "
+                  << CopyThroughput(standard, threads, kOps / threads) << '\n';
+    }
+
+    const LockAdapter<int, AtomicRefCount> weak{WeakPtr<int>(shared)};
+    const std::weak_ptr<int> standard_weak(standard);
+    std::cout << "lock of one object, Mops/s (WeakPtr / std::weak_ptr)\n";
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << "    " << threads << " threads: "
+                  << LockThroughput(weak, threads, kOps / threads) << " / "
+                  << LockThroughput(standard_weak, threads, kOps / threads) << '\n';
+    }
+
+    // after the threads above, so that std::shared_ptr no longer skips its
+    // atomics the way it does while the process has a single thread
+    std::cout << "create + destroy, Mops/s\n";
+    std::cout << "    SharedPtr(new T):  "
+              << CreateThroughput([]() { return SharedPtr<Payload>(new Payload); }, kOps) << '\n';
+    std::cout << "    MakeShared:        "
+              << CreateThroughput([]() { return MakeShared<Payload>(); }, kOps) << '\n';
+    std::cout << "    MakeIntrusive:     "
+              << CreateThroughput([]() { return MakeIntrusive<CountedPayload>(); }, kOps) << '\n';
+    std::cout << "    std::make_shared:  "
+              << CreateThroughput([]() { return std::make_shared<Payload>(); }, kOps) << '\n';
+    return 0;
+}
@@ -0,0 +1,125 @@
+#ifndef INTRUSIVE_PTR_H
+#define INTRUSIVE_PTR_H
+
+#include "shared_ptr.h"
+
+#include <cstddef>
+#include <utility>
+
+// Base for objects that carry their own reference count, so that pointing
+// at them needs no control block at all. IntrusivePtr finds the count
+// through IntrusiveAddRef/IntrusiveRelease, which are looked up next to the
+// pointee; a type with a count of its own may define the two itself
+// instead of deriving from this.
+template<class Derived, class Policy = AtomicRefCount>
+class RefCounted {
+public:
+    RefCounted() : refs_(0) {
+    }
+
+    // a copy is a new object nobody points to yet
+    RefCounted(const RefCounted& /*other*/) : refs_(0) {
+    }
+
+    RefCounted& operator=(const RefCounted& /*other*/) {
+        return *this;
+    }
+
+    size_t UseCount() const {
+        return Policy::Load(refs_);
+    }
+
+    friend void IntrusiveAddRef(const RefCounted* obj) {
+        Policy::Increment(obj->refs_);
+    }
+
+    friend void IntrusiveRelease(const RefCounted* obj) {
+        if (Policy::Decrement(obj->refs_)) {
+            delete static_cast<const Derived*>(obj);
+        }
+    }
+
+protected:
+    ~RefCounted() = default;
+
+private:
+    mutable typename Policy::Count refs_;
+};
+
+template<class T>
+class IntrusivePtr {
+public:
+    IntrusivePtr() : buffer_(nullptr) {
+    }
+
+    // add_ref = false adopts a reference the caller already holds
+    IntrusivePtr(T* new_ptr, bool add_ref = true) : buffer_(new_ptr) {
+        if (buffer_ != nullptr && add_ref) {
+            IntrusiveAddRef(buffer_);
+        }
+    }
+
+    IntrusivePtr(const IntrusivePtr& other) : IntrusivePtr(other.buffer_) {
+    }
+
+    IntrusivePtr& operator=(const IntrusivePtr& other) {
+        IntrusivePtr(other).Swap(*this);
+        return *this;
+    }
+
+    IntrusivePtr(IntrusivePtr&& other) noexcept : buffer_(other.buffer_) {
+        other.buffer_ = nullptr;
+    }
+
+    IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~IntrusivePtr() {
+        if (buffer_ != nullptr) {
+            IntrusiveRelease(buffer_);
+        }
+    }
+
+    void Swap(IntrusivePtr& other) {
+        std::swap(buffer_, other.buffer_);
+    }
+
+    void Reset(T* ptr = nullptr) {
+        IntrusivePtr(ptr).Swap(*this);
+    }
+
+    // gives up the pointer without dropping its reference
+    T* Detach() {
+        T* tmp = buffer_;
+        buffer_ = nullptr;
+        return tmp;
+    }
+
+    T* Get() const noexcept {
+        return buffer_;
+    }
+
+    T& operator*() const {
+        return *buffer_;
+    }
+
+    T* operator->() const {
+        return buffer_;
+    }
+
+    explicit operator bool() const {
+        return buffer_ != nullptr;
+    }
+
+private:
+    T* buffer_;
+};
+
+template<class T, class... Args>
+IntrusivePtr<T> MakeIntrusive(Args&&... args) {
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+#endif // INTRUSIVE_PTR_H
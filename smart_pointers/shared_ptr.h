@@ -1,9 +1,85 @@
 #ifndef SHARED_PTR_H
 #define SHARED_PTR_H
 
+#include <atomic>
+#include <cstddef>
 #include <exception>
+#include <memory>
+#include <new>
+#include <utility>
+
+// How a control block counts references. AtomicRefCount lets copies of one
+// pointer be made and dropped on different threads; PlainRefCount is for
+// pointers that never leave their thread and should not pay for atomics.
+//
+// A new reference is always made from a live one, so Increment needs no
+// ordering. The decrement that reaches zero must see every write other
+// owners made to the object before they let go, hence release on every
+// decrement and acquire on the last. IncrementIfNonZero serves WeakPtr::Lock:
+// a count that has dropped to zero must never be revived.
+struct AtomicRefCount {
+    using Count = std::atomic<size_t>;
+
+    static void Increment(Count& count) {
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // true if this released the last reference
+    static bool Decrement(Count& count) {
+        return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    static bool IncrementIfNonZero(Count& count) {
+        size_t current = count.load(std::memory_order_relaxed);
+        while (current != 0) {
+            if (count.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
 
-template<class T>
+    static size_t Load(const Count& count) {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    // true if count is known to be the only reference left and can be
+    // dropped without a write; only for counts nobody can add to any more
+    static bool IsLast(const Count& count) {
+        return count.load(std::memory_order_acquire) == 1;
+    }
+};
+
+struct PlainRefCount {
+    using Count = size_t;
+
+    static void Increment(Count& count) {
+        ++count;
+    }
+
+    static bool Decrement(Count& count) {
+        return --count == 0;
+    }
+
+    static bool IncrementIfNonZero(Count& count) {
+        if (count == 0) {
+            return false;
+        }
+        ++count;
+        return true;
+    }
+
+    static size_t Load(const Count& count) {
+        return count;
+    }
+
+    static bool IsLast(const Count& count) {
+        return count == 1;
+    }
+};
+
+template<class T, class Policy = AtomicRefCount>
 class WeakPtr;
 
 class BadWeakPtr : public std::exception {
@@ -13,28 +89,92 @@ public:
     }
 };
 
+// The strong owners together hold one weak reference, dropped when the
+// object is destroyed, so whoever drops the last weak reference frees the
+// counter and the two sides never race to delete it. How the object is
+// destroyed and the counter freed depends on where the object lives.
+template<class Policy = AtomicRefCount>
 struct Counter {
-    size_t strong = 0;
-    size_t weak = 0;
+    typename Policy::Count strong;
+    typename Policy::Count weak;
 
-    Counter() = default;
+    Counter() : Counter(1, 1) {
+    }
 
     Counter(size_t strong_cnt, size_t weak_cnt) :
             strong(strong_cnt), weak(weak_cnt) {
     }
 
-    ~Counter() = default;
+    virtual void DestroyObject() = 0;
+
+    virtual void DestroySelf() {
+        delete this;
+    }
+
+    virtual ~Counter() = default;
 };
 
-template<class T>
+// counter of an object that was allocated on its own by new
+template<class T, class Policy>
+struct PointerCounter : Counter<Policy> {
+    T* ptr;
+
+    explicit PointerCounter(T* new_ptr) : ptr(new_ptr) {
+    }
+
+    void DestroyObject() override {
+        delete ptr;
+    }
+};
+
+// The object is built right behind the counts, so one allocation serves
+// both and the count shares a cache line with the start of the object. The
+// storage goes back to the allocator only with the last weak reference.
+template<class T, class Policy, class Alloc>
+struct InplaceCounter : Counter<Policy> {
+    using SelfAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<InplaceCounter>;
+    using SelfTraits = std::allocator_traits<SelfAlloc>;
+    using ObjectAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+    using ObjectTraits = std::allocator_traits<ObjectAlloc>;
+
+    SelfAlloc alloc;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    explicit InplaceCounter(const Alloc& new_alloc) : alloc(new_alloc) {
+    }
+
+    T* Object() {
+        return std::launder(reinterpret_cast<T*>(storage));
+    }
+
+    void DestroyObject() override {
+        ObjectAlloc object_alloc(alloc);
+        ObjectTraits::destroy(object_alloc, Object());
+    }
+
+    void DestroySelf() override {
+        SelfAlloc self_alloc(alloc);
+        this->~InplaceCounter();
+        SelfTraits::deallocate(self_alloc, this, 1);
+    }
+};
+
+template<class T, class Policy = AtomicRefCount>
 class SharedPtr {
+    using CounterType = Counter<Policy>;
 public:
     SharedPtr() : buffer_(nullptr), cnt_(nullptr) {
     }
 
+    // allocates the counter separately; MakeShared saves that allocation
     SharedPtr(T* new_ptr) : buffer_(new_ptr), cnt_(nullptr) {
         if (new_ptr != nullptr) {
-            cnt_ = new Counter(1, 0);
+            try {
+                cnt_ = new PointerCounter<T, Policy>(new_ptr);
+            } catch (...) {
+                delete new_ptr;
+                throw;
+            }
         }
     }
 
@@ -42,12 +182,10 @@ public:
         AddRef();
     }
 
-    SharedPtr(const WeakPtr<T>& other) : buffer_(other.buffer_), cnt_(other.cnt_) {
-        if (other.Expired()) {
+    SharedPtr(const WeakPtr<T, Policy>& other) : buffer_(other.buffer_), cnt_(other.cnt_) {
+        if (cnt_ == nullptr || !Policy::IncrementIfNonZero(cnt_->strong)) {
             throw BadWeakPtr();
         }
-
-        AddRef();
     }
 
     SharedPtr& operator=(const SharedPtr& other) {
@@ -66,7 +204,7 @@ public:
     }
 
     ~SharedPtr() {
-        Reset(nullptr);
+        Release();
     }
 
     void Swap(SharedPtr& other) {
@@ -75,34 +213,17 @@ public:
     }
 
     void Reset(T* ptr = nullptr) {
-        if (cnt_ != nullptr) {
-            if (cnt_->strong > 1) {
-                --(cnt_->strong);
-            } else {
-                delete buffer_;
-                if (cnt_->weak > 0) {
-                    cnt_->strong = 0;
-                } else {
-                    delete cnt_;
-                }
-            }
-        }
-
-        buffer_ = ptr;
-        if (ptr != nullptr) {
-            cnt_ = new Counter(1, 0);
-        } else {
-            cnt_ = nullptr;
-        }
+        SharedPtr(ptr).Swap(*this);
     }
 
     T* Get() const noexcept {
         return buffer_;
     }
 
+    // a snapshot that other threads may change at any moment
     size_t UseCount() const {
         if (cnt_ != nullptr) {
-            return cnt_->strong;
+            return Policy::Load(cnt_->strong);
         } else {
             return 0;
         }
@@ -120,28 +241,48 @@ public:
         return buffer_ != nullptr;
     }
 
-    Counter* GetCounter() const {
+    CounterType* GetCounter() const {
         return cnt_;
     }
 
 private:
+    friend WeakPtr<T, Policy>;
+
+    template<class U, class P, class Alloc, class... Args>
+    friend SharedPtr<U, P> AllocateSharedWithPolicy(const Alloc& alloc, Args&&... args);
+
     T* buffer_;
-    Counter* cnt_;
+    CounterType* cnt_;
+
+    // takes over a strong reference the caller has already counted
+    SharedPtr(T* buffer, CounterType* cnt) : buffer_(buffer), cnt_(cnt) {
+    }
 
     void AddRef() {
         if (cnt_) {
-            ++(cnt_->strong);
+            Policy::Increment(cnt_->strong);
+        }
+    }
+
+    void Release() {
+        if (cnt_ != nullptr && Policy::Decrement(cnt_->strong)) {
+            cnt_->DestroyObject();
+            // with the object gone no new weak reference can appear
+            if (Policy::IsLast(cnt_->weak) || Policy::Decrement(cnt_->weak)) {
+                cnt_->DestroySelf();
+            }
         }
     }
 };
 
-template<class T>
+template<class T, class Policy>
 class WeakPtr {
+    using CounterType = Counter<Policy>;
 public:
     WeakPtr() : buffer_(nullptr), cnt_(nullptr) {
     }
 
-    WeakPtr(const SharedPtr<T>& other) : buffer_(other.Get()), cnt_(other.GetCounter()) {
+    WeakPtr(const SharedPtr<T, Policy>& other) : buffer_(other.Get()), cnt_(other.GetCounter()) {
         AddRef();
     }
 
@@ -165,13 +306,8 @@ public:
     }
 
     ~WeakPtr() {
-        if (cnt_ != nullptr) {
-            --(cnt_->weak);
-
-            if (cnt_->strong == 0 && cnt_->weak == 0) {
-                delete cnt_;
-                buffer_ = nullptr;
-            }
+        if (cnt_ != nullptr && Policy::Decrement(cnt_->weak)) {
+            cnt_->DestroySelf();
         }
     }
 
@@ -186,7 +322,7 @@ public:
 
     size_t UseCount() const {
         if (cnt_ != nullptr) {
-            return cnt_->strong;
+            return Policy::Load(cnt_->strong);
         } else {
             return 0;
         }
@@ -196,21 +332,71 @@ public:
         return UseCount() == 0;
     }
 
-    SharedPtr<T> Lock() const {
-        return (Expired() ? SharedPtr<T>() : SharedPtr<T>(*this));
+    // empty if the object is gone; checking and taking the reference is one
+    // step, so the object cannot die in between
+    SharedPtr<T, Policy> Lock() const {
+        if (cnt_ != nullptr && Policy::IncrementIfNonZero(cnt_->strong)) {
+            return SharedPtr<T, Policy>(buffer_, cnt_);
+        }
+        return SharedPtr<T, Policy>();
     }
 
-    friend SharedPtr<T>;
+    friend SharedPtr<T, Policy>;
 
 private:
     T* buffer_;
-    Counter* cnt_;
+    CounterType* cnt_;
 
     void AddRef() {
         if (cnt_) {
-            ++(cnt_->weak);
+            Policy::Increment(cnt_->weak);
         }
     }
 };
 
+// for objects that stay on one thread
+template<class T>
+using LocalSharedPtr = SharedPtr<T, PlainRefCount>;
+
+template<class T>
+using LocalWeakPtr = WeakPtr<T, PlainRefCount>;
+
+// builds the object and its counter in one block taken from alloc
+template<class T, class Policy, class Alloc, class... Args>
+SharedPtr<T, Policy> AllocateSharedWithPolicy(const Alloc& alloc, Args&&... args) {
+    using CounterType = InplaceCounter<T, Policy, Alloc>;
+    using SelfAlloc = typename CounterType::SelfAlloc;
+    using SelfTraits = std::allocator_traits<SelfAlloc>;
+    using ObjectAlloc = typename CounterType::ObjectAlloc;
+    using ObjectTraits = std::allocator_traits<ObjectAlloc>;
+
+    SelfAlloc self_alloc(alloc);
+    CounterType* cnt = SelfTraits::allocate(self_alloc, 1);
+    new (cnt) CounterType(alloc);
+    try {
+        ObjectAlloc object_alloc(alloc);
+        ObjectTraits::construct(object_alloc, cnt->Object(), std::forward<Args>(args)...);
+    } catch (...) {
+        cnt->~CounterType();
+        SelfTraits::deallocate(self_alloc, cnt, 1);
+        throw;
+    }
+    return SharedPtr<T, Policy>(cnt->Object(), cnt);
+}
+
+template<class T, class Alloc, class... Args>
+SharedPtr<T> AllocateShared(const Alloc& alloc, Args&&... args) {
+    return AllocateSharedWithPolicy<T, AtomicRefCount>(alloc, std::forward<Args>(args)...);
+}
+
+template<class T, class... Args>
+SharedPtr<T> MakeShared(Args&&... args) {
+    return AllocateShared<T>(std::allocator<T>(), std::forward<Args>(args)...);
+}
+
+template<class T, class... Args>
+LocalSharedPtr<T> MakeLocalShared(Args&&... args) {
+    return AllocateSharedWithPolicy<T, PlainRefCount>(std::allocator<T>(), std::forward<Args>(args)...);
+}
+
 #endif // SHARED_PTR_H